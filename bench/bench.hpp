@@ -0,0 +1,84 @@
+#pragma once
+
+#include <GLFWE/window.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace GLFWE::Bench {
+/*
+the only window of a benchmark, never shown and without vsync
+glfwInit does nothing once glfw is initialized, so the hint set here survives Window::create
+*/
+inline Window & hidden_window(glm::vec2 size = {1280, 720}) {
+    glfwInit();
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    Window & window = Window::create("benchmark", size);
+    glfwSwapInterval(0);
+    return window;
+}
+
+// the font the text benchmarks use, passed as the first argument
+inline const char * font_path(int argc, char ** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <font.ttf>\n", argv[0]);
+        std::exit(1);
+    }
+    return argv[1];
+}
+
+// mean milliseconds per call of func over repeats calls, after one untimed warm up call
+template<typename F>
+double time_ms(unsigned int repeats, F && func) {
+    func();
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < repeats; i++) func();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / repeats;
+}
+
+/*
+counts draw calls by wrapping the gl entry points glad loaded, install after the window is created
+*/
+struct DrawCalls {
+    static inline unsigned long count = 0;
+
+    static void install() {
+        draw_arrays = glad_glDrawArrays;
+        draw_arrays_instanced = glad_glDrawArraysInstanced;
+        draw_elements = glad_glDrawElements;
+        glad_glDrawArrays = counted_draw_arrays;
+        glad_glDrawArraysInstanced = counted_draw_arrays_instanced;
+        glad_glDrawElements = counted_draw_elements;
+    }
+
+protected:
+    static inline PFNGLDRAWARRAYSPROC draw_arrays = nullptr;
+    static inline PFNGLDRAWARRAYSINSTANCEDPROC draw_arrays_instanced = nullptr;
+    static inline PFNGLDRAWELEMENTSPROC draw_elements = nullptr;
+
+    static void APIENTRY counted_draw_arrays(GLenum mode, GLint first, GLsizei vertices) {
+        count++;
+        draw_arrays(mode, first, vertices);
+    }
+    static void APIENTRY counted_draw_arrays_instanced(GLenum mode, GLint first, GLsizei vertices, GLsizei instances) {
+        count++;
+        draw_arrays_instanced(mode, first, vertices, instances);
+    }
+    static void APIENTRY counted_draw_elements(GLenum mode, GLsizei vertices, GLenum type, const void * indices) {
+        count++;
+        draw_elements(mode, vertices, type, indices);
+    }
+};
+
+// results are summed into here so the optimizer cannot drop the work that produced them
+inline volatile unsigned long sink = 0;
+inline void keep(unsigned long value) {
+    sink = sink + value;
+}
+
+inline void report(const char * name, double ms, double items, const char * unit) {
+    std::printf("%-40s %10.3f ms %14.0f %s/s\n", name, ms, items / (ms / 1000.0), unit);
+}
+}
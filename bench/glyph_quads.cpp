@@ -0,0 +1,90 @@
+/*
+glyphs laid out per second by the vertex kernel of CharacterSet, without a window or font
+"per vertex" rebuilds six vertices from bearing, size and uv like render_string did before quads were precomputed,
+"write_glyph_quad" is the kernel used now, with SSE where the target has it
+*/
+#include <GLFWE/text/glyph_quad.hpp>
+
+#include "bench.hpp"
+
+#include <vector>
+#include <random>
+
+using namespace GLFWE;
+
+struct Glyph {
+    glm::ivec2 size, bearing;
+    glm::ivec4 uv;
+    float advance;
+    glm::vec4 quad, texels; // precomputed as in CharacterSet::Character::prepare_quad
+};
+
+int main() {
+    constexpr size_t glyph_count = 1 << 20;
+    constexpr unsigned int repeats = 20;
+    const float scale = 0.75f;
+
+    std::mt19937 random(42);
+    std::vector<Glyph> font(128);
+    for (Glyph & glyph : font) {
+        glyph.size = glm::ivec2(random() % 40, random() % 48);
+        glyph.bearing = glm::ivec2(random() % 6, glyph.size.y - random() % 12);
+        glyph.uv = glm::ivec4(random() % 900, random() % 900, 0, 0);
+        glyph.uv.z = glyph.uv.x + glyph.size.x;
+        glyph.uv.w = glyph.uv.y + glyph.size.y;
+        glyph.advance = glyph.size.x + 2;
+        glyph.quad = glm::vec4(glyph.bearing.x, glyph.bearing.y - glyph.size.y, glyph.bearing.x + glyph.size.x, glyph.bearing.y);
+        glyph.texels = glm::vec4(glyph.uv);
+    }
+    std::vector<unsigned char> text(glyph_count);
+    for (unsigned char & c : text) c = random() % 128;
+
+    std::vector<Text::GlyphVertex> out;
+    unsigned int color = pack_color(glm::vec4(1.0f));
+
+    // both write through the same cursor into a presized buffer, only the per glyph work differs
+    double before = Bench::time_ms(repeats, [&]() {
+        out.resize(text.size() * 6);
+        Text::GlyphVertex * cursor = out.data();
+        glm::vec2 pen(0.0f);
+        for (unsigned char c : text) {
+            const Glyph & ch = font[c];
+            float xpos = pen.x + ch.bearing.x * scale, ypos = pen.y - (ch.size.y - ch.bearing.y) * scale;
+            float w = ch.size.x * scale, h = ch.size.y * scale;
+            float u0 = ch.uv.x, v0 = ch.uv.y, u1 = ch.uv.z, v1 = ch.uv.w;
+
+            cursor[0] = {{xpos,     ypos + h}, {u0, v0}, color};
+            cursor[1] = {{xpos,     ypos    }, {u0, v1}, color};
+            cursor[2] = {{xpos + w, ypos    }, {u1, v1}, color};
+
+            cursor[3] = {{xpos,     ypos + h}, {u0, v0}, color};
+            cursor[4] = {{xpos + w, ypos    }, {u1, v1}, color};
+            cursor[5] = {{xpos + w, ypos + h}, {u1, v0}, color};
+            cursor += 6;
+            pen.x += ch.advance * scale;
+        }
+        Bench::keep(cursor - out.data());
+    });
+
+    double after = Bench::time_ms(repeats, [&]() {
+        out.resize(text.size() * 6);
+        Text::GlyphVertex * cursor = out.data();
+        glm::vec2 pen(0.0f);
+        for (unsigned char c : text) {
+            const Glyph & ch = font[c];
+            Text::write_glyph_quad(cursor, pen, scale, ch.quad, ch.texels, color);
+            cursor += 6;
+            pen.x += ch.advance * scale;
+        }
+        Bench::keep(cursor - out.data());
+    });
+
+#ifdef GLFWE_TEXT_SSE
+    std::printf("write_glyph_quad uses SSE\n");
+#else
+    std::printf("write_glyph_quad uses the scalar path\n");
+#endif
+    Bench::report("per vertex", before, glyph_count, "glyphs");
+    Bench::report("write_glyph_quad", after, glyph_count, "glyphs");
+    return 0;
+}
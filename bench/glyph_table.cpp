@@ -0,0 +1,66 @@
+/*
+glyph lookups during layout, the flat table of CharacterSet against the std::map<char, Character> it replaced
+both walk the same 1M ascii characters with the same pen arithmetic, only the lookup differs
+layout_string is the whole layout path, with utf-8 decoding, kerning and atlas bookkeeping
+*/
+#include <GLFWE/text/character_set.hpp>
+
+#include "bench.hpp"
+
+#include <map>
+#include <random>
+#include <string>
+
+using namespace GLFWE;
+
+struct Font : Text::CharacterSet {
+    using CharacterSet::CharacterSet;
+
+    // the layout loop of render_string, glyphs are looked up through lookup
+    template<typename Lookup>
+    float layout(const std::string & text, float scale, Lookup && lookup) {
+        glm::vec2 pen(0.0f);
+        float checksum = 0;
+        for (char c : text) {
+            const Character & ch = lookup(c);
+            float xpos = pen.x + ch.bearing.x * scale;
+            float ypos = pen.y - (ch.size.y - ch.bearing.y) * scale;
+            checksum += xpos + ypos + ch.size.x * scale;
+            pen.x += (ch.advance >> 6) * scale;
+        }
+        return checksum;
+    }
+
+    void run(const std::string & text, unsigned int repeats) {
+        preload(32, 127);
+        std::map<char, Character> map;
+        for (char c = 32; c < 127; c++) map[c] = find_character(c);
+
+        double before = Bench::time_ms(repeats, [&]() {
+            Bench::keep(layout(text, 1.0f, [&](char c) -> const Character & { return map[c]; }));
+        });
+        double after = Bench::time_ms(repeats, [&]() {
+            Bench::keep(layout(text, 1.0f, [&](char c) -> const Character & { return find_character(c); }));
+        });
+        double full = Bench::time_ms(repeats, [&]() {
+            Bench::keep(layout_string(text, glm::vec2(0.0f), 1.0f).glyphs.size());
+        });
+
+        Bench::report("std::map lookups", before, text.size(), "glyphs");
+        Bench::report("flat table lookups", after, text.size(), "glyphs");
+        Bench::report("layout_string", full, text.size(), "glyphs");
+    }
+};
+
+int main(int argc, char ** argv) {
+    const char * path = Bench::font_path(argc, argv);
+    Bench::hidden_window();
+
+    std::mt19937 random(42);
+    std::string text(1 << 20, ' ');
+    for (char & c : text) c = 32 + random() % 95;
+
+    Font font(path, 32);
+    font.run(text, 20);
+    return 0;
+}
@@ -0,0 +1,84 @@
+/*
+point in convex polygon tests against a grid of tens of thousands of hexagonal cells, without a window
+"scalar" is ConvexPolygon::contains_point once per cell or point, the batch calls use AVX or SSE where the target has
+them (configure with -Dcpp_args=-mavx for the 8 wide kernels)
+*/
+#include <GLFWE/shape/convex_polygon.hpp>
+#include <GLFWE/shape/polygon_query.hpp>
+
+#include "bench.hpp"
+
+#include <vector>
+#include <random>
+#include <cmath>
+
+using namespace GLFWE;
+
+int main() {
+    constexpr int columns = 200, rows = 200;
+    constexpr float radius = 10.0f;
+    constexpr size_t point_count = 1 << 16;
+    constexpr unsigned int repeats = 50;
+
+    std::vector<std::vector<glm::vec2>> cells;
+    std::vector<Shape::ConvexPolygon> polygons;
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+            glm::vec2 center(column * radius * 1.5f, (row + (column % 2) * 0.5f) * radius * std::sqrt(3.0f));
+            std::vector<glm::vec2> hexagon;
+            for (int corner = 0; corner < 6; corner++) {
+                float angle = corner * 3.14159265f / 3.0f;
+                hexagon.push_back(center + radius * glm::vec2(std::cos(angle), std::sin(angle)));
+            }
+            cells.push_back(hexagon);
+            polygons.emplace_back(hexagon.begin(), hexagon.end());
+        }
+    }
+    Shape::PolygonSet set(cells);
+
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> x(0.0f, columns * radius * 1.5f), y(0.0f, rows * radius * std::sqrt(3.0f));
+    std::vector<glm::vec2> points(point_count);
+    for (glm::vec2 & point : points) point = {x(random), y(random)};
+
+#if defined(GLFWE_SHAPE_AVX)
+    std::printf("batch kernels use AVX and SSE\n");
+#elif defined(GLFWE_SHAPE_SSE)
+    std::printf("batch kernels use SSE\n");
+#else
+    std::printf("batch kernels use the scalar path\n");
+#endif
+
+    // one cursor position against every cell
+    size_t cursor = 0;
+    double one_point_scalar = Bench::time_ms(repeats, [&]() {
+        glm::vec2 point = points[cursor++ % point_count];
+        unsigned long hits = 0;
+        for (const Shape::ConvexPolygon & polygon : polygons) hits += polygon.contains_point(point);
+        Bench::keep(hits);
+    });
+    std::vector<size_t> hits;
+    double one_point_batch = Bench::time_ms(repeats, [&]() {
+        set.find_containing(points[cursor++ % point_count], hits);
+        Bench::keep(hits.size());
+    });
+    Bench::report("1 point x cells, scalar", one_point_scalar, polygons.size(), "tests");
+    Bench::report("1 point x cells, PolygonSet", one_point_batch, polygons.size(), "tests");
+
+    // every point against one cell
+    Shape::PolygonQuery query(cells[cells.size() / 2]);
+    const Shape::ConvexPolygon & cell = polygons[cells.size() / 2];
+    double many_points_scalar = Bench::time_ms(repeats, [&]() {
+        unsigned long inside = 0;
+        for (glm::vec2 point : points) inside += cell.contains_point(point);
+        Bench::keep(inside);
+    });
+    std::vector<unsigned char> inside;
+    double many_points_batch = Bench::time_ms(repeats, [&]() {
+        query.contains_points(points, inside);
+        Bench::keep(inside[0]);
+    });
+    Bench::report("points x 1 cell, scalar", many_points_scalar, point_count, "tests");
+    Bench::report("points x 1 cell, PolygonQuery", many_points_batch, point_count, "tests");
+    return 0;
+}
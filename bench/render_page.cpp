@@ -0,0 +1,61 @@
+/*
+draw calls and frame time of a 10k character page of text, in a hidden window
+"per glyph" calls render_string once per character, which uploads and draws every glyph on its own like render_string
+did before it batched whole strings, "per string" draws the page as one string
+frame time includes glFinish, so it covers the gpu as well
+*/
+#include <GLFWE/text/character_set.hpp>
+
+#include "bench.hpp"
+
+#include <random>
+#include <string>
+
+using namespace GLFWE;
+
+int main(int argc, char ** argv) {
+    const char * path = Bench::font_path(argc, argv);
+    Window & window = Bench::hidden_window({1280, 1600});
+    Bench::DrawCalls::install();
+
+    constexpr int columns = 100, rows = 100;
+    constexpr unsigned int repeats = 50;
+    const float scale = 0.5f;
+
+    std::mt19937 random(42);
+    std::string page;
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) page += (char) (random() % 5 == 0 ? ' ' : 'a' + random() % 26);
+        page += '\n';
+    }
+
+    Text::CharacterSet font(path, 32);
+    float line_height = font.get_line_height() * scale;
+    glm::vec2 top_left(10.0f, 1600.0f - line_height);
+
+    // pen positions of every character, so the per glyph frame does not pay for layout twice
+    Text::TextLayout layout = font.layout_string(page, top_left, scale);
+    std::vector<std::string> glyphs;
+    for (char c : page) if (c != '\n') glyphs.push_back(std::string(1, c));
+
+    unsigned long calls = Bench::DrawCalls::count;
+    double per_glyph = Bench::time_ms(repeats, [&]() {
+        window.clear_color({0, 0, 0});
+        for (size_t i = 0; i < glyphs.size(); i++) font.render_string(glyphs[i], layout.glyphs[i].pen, scale, {1, 1, 1});
+        glFinish();
+    });
+    unsigned long per_glyph_calls = (Bench::DrawCalls::count - calls) / (repeats + 1);
+
+    calls = Bench::DrawCalls::count;
+    double per_string = Bench::time_ms(repeats, [&]() {
+        window.clear_color({0, 0, 0});
+        font.render_string(page, top_left, scale, {1, 1, 1});
+        glFinish();
+    });
+    unsigned long per_string_calls = (Bench::DrawCalls::count - calls) / (repeats + 1);
+
+    std::printf("%zu glyphs, %lu draw calls per frame drawn per glyph, %lu drawn per string\n", glyphs.size(), per_glyph_calls, per_string_calls);
+    Bench::report("per glyph", per_glyph, 1, "frames");
+    Bench::report("per string", per_string, 1, "frames");
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*
+cpu time per frame of 1,000 labels that never change, in a hidden window
+"render_string" lays out and uploads every label again each frame, "TextBlock" uploads once and only draws
+the time stops before glFinish, which runs after every frame so queued gpu work does not pile up into the next one
+*/
+#include <GLFWE/text/character_set.hpp>
+#include <GLFWE/text/text_block.hpp>
+
+#include "bench.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace GLFWE;
+
+// mean cpu milliseconds of draw_frame over frames frames, after one untimed frame
+template<typename F>
+double frame_cpu_ms(unsigned int frames, F && draw_frame) {
+    draw_frame();
+    glFinish();
+
+    std::chrono::duration<double, std::milli> total(0);
+    for (unsigned int i = 0; i < frames; i++) {
+        auto start = std::chrono::steady_clock::now();
+        draw_frame();
+        total += std::chrono::steady_clock::now() - start;
+        glFinish();
+    }
+    return total.count() / frames;
+}
+
+int main(int argc, char ** argv) {
+    const char * path = Bench::font_path(argc, argv);
+    Window & window = Bench::hidden_window({1280, 720});
+
+    constexpr unsigned int label_count = 1000, frames = 100;
+    const float scale = 0.5f;
+
+    Text::CharacterSet font(path, 32);
+    std::vector<std::string> texts;
+    std::vector<glm::vec2> positions;
+    for (unsigned int i = 0; i < label_count; i++) {
+        texts.push_back("label " + std::to_string(i) + ": " + std::to_string(i * 37 % 1000) + " units");
+        positions.push_back(glm::vec2(10 + (i % 8) * 160, 10 + (i / 8) * 5.5f));
+    }
+
+    std::vector<Text::TextBlock> blocks;
+    blocks.reserve(label_count);
+    for (unsigned int i = 0; i < label_count; i++) blocks.emplace_back(font, texts[i], positions[i], scale);
+
+    double immediate = frame_cpu_ms(frames, [&]() {
+        window.clear_color({0, 0, 0});
+        for (unsigned int i = 0; i < label_count; i++) font.render_string(texts[i], positions[i], scale, {1, 1, 1});
+    });
+    double retained = frame_cpu_ms(frames, [&]() {
+        window.clear_color({0, 0, 0});
+        for (Text::TextBlock & block : blocks) block.draw();
+    });
+
+    Bench::report("render_string", immediate, 1, "frames");
+    Bench::report("TextBlock", retained, 1, "frames");
+    return 0;
+}
@@ -33,8 +33,11 @@ public:
 
     void destroy() {
         if (!glfw_buffer || Window::has_terminated()) return;
+        // deleting a bound buffer unbinds it, a new buffer reusing the id must not be mistaken for bound
+        if (current_bound == glfw_buffer) current_bound = 0;
         glDeleteBuffers(1, &glfw_buffer);
         logger << "Buffer " << glfw_buffer << " destroyed"; 
+        glfw_buffer = 0;
     }
 
     unsigned int id() {
@@ -42,6 +45,7 @@ public:
     }
 
     #define ARRAY_BUFFER GL_ARRAY_BUFFER
+    #define ELEMENT_ARRAY_BUFFER GL_ELEMENT_ARRAY_BUFFER
 
     #define STREAM_DRAW GL_STREAM_DRAW // set once & only used a few times
     #define STATIC_DRAW GL_STATIC_DRAW // set once & used many times
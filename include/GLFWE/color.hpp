@@ -0,0 +1,11 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace GLFWE {
+// rgba8, red in the lowest byte, as read by a normalized GL_UNSIGNED_BYTE vertex attribute
+inline unsigned int pack_color(glm::vec4 color) {
+    auto channel = [](float value) { return (unsigned int)(glm::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    return channel(color.r) | channel(color.g) << 8 | channel(color.b) << 16 | channel(color.a) << 24;
+}
+}
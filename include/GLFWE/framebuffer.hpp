@@ -0,0 +1,77 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <GLFWE/window.hpp>
+#include <GLFWE/texture.hpp>
+
+#include <logger/logger.hpp>
+
+namespace GLFWE {
+// offscreen render target, draws go into the attached texture while it is bound
+class Framebuffer {
+protected:
+    static constexpr Logger logger = Logger("Framebuffer");
+
+    unsigned int glfw_framebuffer;
+
+public:
+    Framebuffer() {
+        glGenFramebuffers(1, &glfw_framebuffer);
+        logger << "Framebuffer " << glfw_framebuffer << " successfully created";
+    }
+
+    Framebuffer(Framebuffer & other) = delete;
+    Framebuffer(Framebuffer && other): glfw_framebuffer(other.glfw_framebuffer) {
+        other.glfw_framebuffer = 0;
+    }
+
+    ~Framebuffer() {
+        if (glfw_framebuffer) destroy();
+    }
+
+    void destroy() {
+        if (!glfw_framebuffer || Window::has_terminated()) return;
+        if (current_bound == glfw_framebuffer) bind_id(0);
+        glDeleteFramebuffers(1, &glfw_framebuffer);
+        logger << "Framebuffer " << glfw_framebuffer << " destroyed";
+        glfw_framebuffer = 0;
+    }
+
+    unsigned int id() {
+        return glfw_framebuffer;
+    }
+
+    #define COLOR_ATTACHMENT GL_COLOR_ATTACHMENT0
+
+    // the texture must already have storage, e.g. from buffer_image_2D with null data
+    Framebuffer && attach_texture(Texture & texture, GLenum attachment = COLOR_ATTACHMENT) {
+        bind();
+        glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, texture.id(), 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            logger.log(Logger::WARNING) << "Framebuffer " << glfw_framebuffer << " is incomplete after attaching texture " << texture.id();
+        }
+        return std::move(*this);
+    }
+
+protected:
+    static unsigned int current_bound;
+public:
+    void bind() {
+        if (!glfw_framebuffer) logger.log(Logger::WARNING) << "Attempting to bind a framebuffer ID 0";
+        bind_id(glfw_framebuffer);
+    }
+
+    // 0 is the window
+    static void bind_id(unsigned int framebuffer_id) {
+        if (current_bound == framebuffer_id) return;
+        current_bound = framebuffer_id;
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_id);
+    }
+
+    static unsigned int get_bound() {
+        return current_bound;
+    }
+};
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <logger/logger.hpp>
+
+#include <filesystem>
+#include <cstddef>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace GLFWE {
+// read only memory mapping of a whole file
+class MappedFile {
+protected:
+    static constexpr Logger logger = Logger("Mapped File");
+
+    const unsigned char * mapped_data = nullptr;
+    size_t mapped_size = 0;
+
+public:
+    MappedFile(const std::filesystem::path & path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void * address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (address != MAP_FAILED) {
+                mapped_data = (const unsigned char *) address;
+                mapped_size = info.st_size;
+            } else {
+                logger.log(Logger::WARNING) << "Failed to map file: " << path.c_str();
+            }
+        }
+        close(fd); // the mapping stays valid without the descriptor
+    }
+
+    MappedFile(MappedFile & other) = delete;
+    MappedFile(MappedFile && other):
+    mapped_data(other.mapped_data),
+    mapped_size(other.mapped_size) {
+        other.mapped_data = nullptr;
+        other.mapped_size = 0;
+    }
+
+    ~MappedFile() {
+        if (mapped_data) destroy();
+    }
+
+    void destroy() {
+        if (!mapped_data) return;
+        munmap((void *) mapped_data, mapped_size);
+        mapped_data = nullptr;
+        mapped_size = 0;
+    }
+
+    // false if the file could not be opened, was empty or could not be mapped
+    bool is_open() {
+        return mapped_data != nullptr;
+    }
+
+    const unsigned char * data() {
+        return mapped_data;
+    }
+
+    size_t size() {
+        return mapped_size;
+    }
+
+    // 64 bit FNV-1a of the contents, used to notice when a file changed
+    unsigned long long hash() {
+        unsigned long long value = 14695981039346656037ull;
+        for (size_t i = 0; i < mapped_size; i++) {
+            value = (value ^ mapped_data[i]) * 1099511628211ull;
+        }
+        return value;
+    }
+};
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <map>
+
+namespace GLFWE {
+/*
+hands out ranges of a fixed size region (usually the elements of a gpu buffer)
+first fit over a free list sorted by offset, neighbouring free ranges are merged when released
+only book keeping, the region itself is owned by whoever uses the allocator
+*/
+class RangeAllocator {
+protected:
+    std::map<unsigned int, unsigned int> free_ranges; // offset -> size
+    unsigned int capacity = 0;
+    unsigned int used = 0;
+
+public:
+    RangeAllocator(unsigned int _capacity = 0) {
+        reset(_capacity);
+    }
+
+    // forgets every allocation
+    void reset(unsigned int new_capacity) {
+        free_ranges.clear();
+        capacity = new_capacity;
+        used = 0;
+        if (capacity) free_ranges[0] = capacity;
+    }
+
+    // returns false if no free range is large enough, grow() and try again
+    bool allocate(unsigned int size, unsigned int & offset) {
+        if (size == 0) {
+            offset = 0;
+            return true;
+        }
+
+        for (auto it = free_ranges.begin(); it != free_ranges.end(); it++) {
+            if (it->second < size) continue;
+
+            offset = it->first;
+            unsigned int remaining = it->second - size;
+            free_ranges.erase(it);
+            if (remaining) free_ranges[offset + size] = remaining;
+            used += size;
+            return true;
+        }
+        return false;
+    }
+
+    void free(unsigned int offset, unsigned int size) {
+        if (size == 0) return;
+        used -= size;
+
+        auto next = free_ranges.lower_bound(offset);
+
+        // merge with the free range right before
+        if (next != free_ranges.begin()) {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == offset) {
+                offset = previous->first;
+                size += previous->second;
+                free_ranges.erase(previous);
+            }
+        }
+        // and the one right after
+        if (next != free_ranges.end() && offset + size == next->first) {
+            size += next->second;
+            free_ranges.erase(next);
+        }
+        free_ranges[offset] = size;
+    }
+
+    // extends the region, existing allocations keep their offsets
+    void grow(unsigned int new_capacity) {
+        if (new_capacity <= capacity) return;
+        unsigned int old_capacity = capacity;
+        capacity = new_capacity;
+        used += new_capacity - old_capacity; // free() subtracts it again
+        free(old_capacity, new_capacity - old_capacity);
+    }
+
+    unsigned int get_capacity() {
+        return capacity;
+    }
+
+    unsigned int get_used() {
+        return used;
+    }
+};
+}
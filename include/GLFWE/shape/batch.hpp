@@ -0,0 +1,173 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <GLFWE/window.hpp>
+#include <GLFWE/shader.hpp>
+#include <GLFWE/shader_program.hpp>
+#include <GLFWE/vertex_array.hpp>
+#include <GLFWE/color.hpp>
+
+#include <GLFWE/shape/convex_polygon.hpp>
+#include <GLFWE/shape/shape_shader.hpp>
+
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+#include <logger/logger.hpp>
+
+namespace GLFWE::Shape {
+/*
+collects many convex polygons into one vertex stream and draws all of them with a single draw call on flush()
+every vertex carries its own color and depth, polygons are split into triangle fans in an index buffer
+like ConvexPolygon::draw, depth only orders shapes when depth testing is enabled, otherwise later shapes are on top
+*/
+class Batch {
+public:
+    struct Vertex {
+        glm::vec2    position;
+        float        depth;
+        unsigned int color; // rgba8, red in the lowest byte
+    };
+
+protected:
+    static constexpr Logger logger = Logger("Shape Batch");
+
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+
+    GLFWE::VertexArray VAO;
+    unsigned int vertex_capacity = 0; // bytes currently allocated in the vertex buffer
+    unsigned int index_capacity = 0;  // bytes currently allocated in the index buffer
+
+    static std::unique_ptr<GLFWE::ShaderProgram> program;
+
+public:
+    Batch() {
+        load();
+        VAO.assign_vertex_attribute(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), offsetof(Vertex, position));
+        VAO.assign_vertex_attribute(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Vertex), offsetof(Vertex, color));
+    }
+
+    Batch(Batch & other) = delete;
+    Batch(Batch && other) = default;
+
+    // adds a convex polygon, points in order either clockwise or counterclockwise
+    Batch && add(const std::vector<glm::vec2> & polygon, glm::vec4 color, float depth = 0) {
+        if (polygon.size() < 3) return std::move(*this);
+        unsigned int first = vertices.size();
+        unsigned int packed = pack_color(color);
+
+        for (glm::vec2 point : polygon) vertices.push_back({point, depth, packed});
+        for (unsigned int i = 1; i + 1 < polygon.size(); i++) {
+            indices.push_back(first);
+            indices.push_back(first + i);
+            indices.push_back(first + i + 1);
+        }
+        return std::move(*this);
+    }
+    Batch && add(const std::vector<glm::vec2> & polygon, glm::vec3 color, float depth = 0) {
+        return add(polygon, glm::vec4(color, 1.0f), depth);
+    }
+
+    // same as add(Rectangle(position, dimentions)), without building the polygon
+    Batch && add_rectangle(glm::vec2 position, glm::vec2 dimentions, glm::vec4 color, float depth = 0) {
+        unsigned int first = vertices.size();
+        unsigned int packed = pack_color(color);
+
+        vertices.push_back({position, depth, packed});
+        vertices.push_back({position + glm::vec2{dimentions.x, 0}, depth, packed});
+        vertices.push_back({position + dimentions, depth, packed});
+        vertices.push_back({position + glm::vec2{0, dimentions.y}, depth, packed});
+        for (unsigned int index : {0, 1, 2, 0, 2, 3}) indices.push_back(first + index);
+        return std::move(*this);
+    }
+    Batch && add_rectangle(glm::vec2 position, glm::vec2 dimentions, glm::vec3 color, float depth = 0) {
+        return add_rectangle(position, dimentions, glm::vec4(color, 1.0f), depth);
+    }
+
+    // reserves room for shape_count shapes of vertices_per_shape points each
+    void reserve(size_t shape_count, size_t vertices_per_shape = 4) {
+        vertices.reserve(shape_count * vertices_per_shape);
+        indices.reserve(shape_count * (vertices_per_shape - 2) * 3);
+    }
+
+    size_t get_vertex_count() { return vertices.size(); }
+    size_t get_index_count() { return indices.size(); }
+
+    // drops everything added so far, keeping the memory for the next frame
+    void clear() {
+        vertices.clear();
+        indices.clear();
+    }
+
+    // uploads and draws everything added since the last flush, then clears the batch
+    void flush() {
+        if (indices.empty()) return;
+
+        unsigned int vertex_size = sizeof(Vertex) * vertices.size();
+        unsigned int index_size = sizeof(unsigned int) * indices.size();
+
+        // buffers only grow, most frames reuse the storage with a sub data upload
+        if (vertex_size > vertex_capacity) {
+            vertex_capacity = std::max(vertex_capacity * 2, vertex_size);
+            VAO.buffer_vertex_data(vertex_capacity, NULL, DYNAMIC_DRAW);
+        }
+        if (index_size > index_capacity) {
+            index_capacity = std::max(index_capacity * 2, index_size);
+            VAO.buffer_index_data(index_capacity, NULL, DYNAMIC_DRAW);
+        }
+        VAO.buffer_vertex_sub_data(0, vertex_size, vertices.data());
+        VAO.buffer_index_sub_data(0, index_size, indices.data());
+
+        program->use();
+        VAO.draw_elements(GL_TRIANGLES, indices.size());
+        clear();
+    }
+
+    static void set_projection(glm::vec2 projection) {
+        load();
+        set_program_projection(*program, projection);
+    }
+
+    static void clean() {
+        program.release();
+    }
+
+protected:
+    static void load() {
+        if (program != nullptr) return; // already initialized
+        program = std::make_unique<ShaderProgram>();
+
+        Shader vertex_shader = Shader(VERTEX_SHADER).load_raw(R"(
+            #version 330 core
+            layout (location = 0) in vec3 aPos;
+            layout (location = 1) in vec4 aColor;
+
+            uniform mat4 projection;
+
+            out vec4 vertexColor;
+
+            void main()
+            {
+                gl_Position = projection * vec4(aPos, 1.0);
+                vertexColor = aColor;
+        })");
+        Shader fragment_shader = Shader(FRAGMENT_SHADER).load_raw(R"(
+            #version 330 core
+            in vec4 vertexColor;
+            out vec4 FragColor;
+
+            void main()
+            {
+                FragColor = vertexColor;
+            }
+        )");
+
+        program->attach_shader(vertex_shader).attach_shader(fragment_shader).link();
+
+        set_automatic_projection(*program, logger, "Batch");
+    }
+};
+}
@@ -15,16 +15,24 @@ namespace GLFWE::Shape {
 class ConvexPolygon: public std::vector<glm::vec2> {
 public:
     using std::vector<glm::vec2>::vector;
-    bool contains_point(glm::vec2 point) {
-        bool last_direction = glm::cross(glm::vec3{at(0)-at(size()-1), 0}, glm::vec3{point-at(size()-1), 0}).z >= 0;
-        for (int i = 1; i < size(); i++) {
-            if (last_direction != glm::cross(glm::vec3{at(i)-at(i-1), 0}, glm::vec3{point-at(i-1), 0}).z >= 0) {
+    // for many points or polygons at once see PolygonQuery and PolygonSet in polygon_query.hpp
+    bool contains_point(glm::vec2 point) const {
+        if (size() < 3) return false;
+        const glm::vec2 * points = data();
+        bool last_direction = cross(points[0] - points[size()-1], point - points[size()-1]) >= 0;
+        for (size_t i = 1; i < size(); i++) {
+            if (last_direction != (cross(points[i] - points[i-1], point - points[i-1]) >= 0)) {
                 return false;
-            };
+            }
         }
         return true;
     }
 
+    // z of the 3d cross product
+    static float cross(glm::vec2 a, glm::vec2 b) {
+        return a.x * b.y - a.y * b.x;
+    }
+
 
 protected:
     static std::unique_ptr<VertexArray> VAO;
@@ -55,8 +63,8 @@ public:
         if (VAO.get() == nullptr) init_vao();
         VAO->bind();
 
-        VAO->buffer_vertex_data(sizeof(data()) * size(), data(), DYNAMIC_DRAW);
-        VAO->draw(GL_TRIANGLE_FAN, 4);
+        VAO->buffer_vertex_data(sizeof(glm::vec2) * size(), data(), DYNAMIC_DRAW);
+        VAO->draw(GL_TRIANGLE_FAN, size());
     }
 
 protected:
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <GLFWE/window.hpp>
+#include <GLFWE/shader.hpp>
+#include <GLFWE/shader_program.hpp>
+#include <GLFWE/vertex_array.hpp>
+#include <GLFWE/color.hpp>
+
+#include <GLFWE/shape/premade.hpp>
+#include <GLFWE/shape/shape_shader.hpp>
+
+#include <vector>
+#include <memory>
+#include <cmath>
+#include <cstddef>
+
+#include <logger/logger.hpp>
+
+namespace GLFWE::Shape {
+/*
+rectangles and lines drawn as instances of one static unit quad, 36 bytes each and all of them in a single draw call
+instances stay on the gpu between draws, only the range changed since the last draw is uploaded again
+like ConvexPolygon::draw, depth only orders shapes when depth testing is enabled, otherwise later shapes are on top
+*/
+class InstancedQuads {
+public:
+    struct Instance {
+        glm::vec2    position;
+        glm::vec2    size;
+        glm::vec2    anchor;   // point of the quad placed at position and rotated around, (0, 0) is a corner, (0.5, 0.5) the center
+        float        rotation; // radians, counterclockwise
+        float        depth;
+        unsigned int color;    // rgba8, red in the lowest byte
+    };
+    static_assert(sizeof(Instance) == 36, "Instance is read as two vec4 and a color");
+
+protected:
+    static constexpr Logger logger = Logger("Instanced Quads");
+
+    std::vector<Instance> instances;
+    size_t dirty_begin = 0, dirty_end = 0; // instances not uploaded yet
+    unsigned int capacity = 0;             // bytes currently allocated in the instance buffer
+
+    GLFWE::VertexArray VAO;
+
+    static std::unique_ptr<GLFWE::ShaderProgram> program;
+
+public:
+    InstancedQuads() {
+        load();
+
+        float unit_quad[4][2] = {{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+        VAO.buffer_vertex_data(sizeof(unit_quad), unit_quad, STATIC_DRAW);
+        VAO.assign_vertex_attribute(0, 2, GL_FLOAT, GL_FALSE, 2*sizeof(float));
+
+        VAO.buffer_instance_data(0, NULL, DYNAMIC_DRAW);
+        VAO.assign_instance_attribute(1, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), offsetof(Instance, position)); // position & size
+        VAO.assign_instance_attribute(2, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), offsetof(Instance, anchor));   // anchor, rotation & depth
+        VAO.assign_instance_attribute(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Instance), offsetof(Instance, color));
+    }
+
+    InstancedQuads(InstancedQuads & other) = delete;
+    InstancedQuads(InstancedQuads && other) = default;
+
+    // returns the index of the new instance, for later calls to set()
+    size_t add(const Instance & instance) {
+        instances.push_back(instance);
+        mark_dirty(instances.size() - 1);
+        return instances.size() - 1;
+    }
+
+    // same placement as Shape::Rectangle, rotation turns it around position
+    size_t add_rectangle(glm::vec2 position, glm::vec2 dimentions, glm::vec4 color, Center center = TOP_LEFT, float rotation = 0, float depth = 0) {
+        return add(rectangle_instance(position, dimentions, color, center, rotation, depth));
+    }
+    size_t add_rectangle(glm::vec2 position, glm::vec2 dimentions, glm::vec3 color, Center center = TOP_LEFT, float rotation = 0, float depth = 0) {
+        return add_rectangle(position, dimentions, glm::vec4(color, 1.0f), center, rotation, depth);
+    }
+
+    // same quad as Shape::line, thickness is measured from the center line to either edge
+    size_t add_line(glm::vec2 point_a, glm::vec2 point_b, float thickness, glm::vec4 color, float depth = 0) {
+        return add(line_instance(point_a, point_b, thickness, color, depth));
+    }
+    size_t add_line(glm::vec2 point_a, glm::vec2 point_b, float thickness, glm::vec3 color, float depth = 0) {
+        return add_line(point_a, point_b, thickness, glm::vec4(color, 1.0f), depth);
+    }
+
+    void set(size_t index, const Instance & instance) {
+        instances[index] = instance;
+        mark_dirty(index);
+    }
+    void set_color(size_t index, glm::vec4 color) {
+        instances[index].color = pack_color(color);
+        mark_dirty(index);
+    }
+
+    const Instance & get(size_t index) {
+        return instances[index];
+    }
+    size_t size() {
+        return instances.size();
+    }
+
+    void reserve(size_t count) {
+        instances.reserve(count);
+    }
+
+    void clear() {
+        instances.clear();
+        dirty_begin = dirty_end = 0;
+    }
+
+    void draw() {
+        if (instances.empty()) return;
+        upload();
+
+        program->use();
+        VAO.draw_instanced(GL_TRIANGLE_STRIP, 4, instances.size());
+    }
+
+    static Instance rectangle_instance(glm::vec2 position, glm::vec2 dimentions, glm::vec4 color, Center center = TOP_LEFT, float rotation = 0, float depth = 0) {
+        glm::vec2 anchor = center == CENTER ? glm::vec2(0.5f) : glm::vec2(0.0f);
+        return {position, dimentions, anchor, rotation, depth, pack_color(color)};
+    }
+
+    static Instance line_instance(glm::vec2 point_a, glm::vec2 point_b, float thickness, glm::vec4 color, float depth = 0) {
+        glm::vec2 direction = point_b - point_a;
+        return {point_a, {glm::length(direction), thickness * 2}, {0.0f, 0.5f}, std::atan2(direction.y, direction.x), depth, pack_color(color)};
+    }
+
+    static void set_projection(glm::vec2 projection) {
+        load();
+        set_program_projection(*program, projection);
+    }
+
+    static void clean() {
+        program.release();
+    }
+
+protected:
+    void mark_dirty(size_t index) {
+        if (dirty_begin == dirty_end) {
+            dirty_begin = index;
+            dirty_end = index + 1;
+            return;
+        }
+        dirty_begin = std::min(dirty_begin, index);
+        dirty_end = std::max(dirty_end, index + 1);
+    }
+
+    void upload() {
+        unsigned int data_size = sizeof(Instance) * instances.size();
+        if (data_size > capacity) {
+            // the new storage starts empty, so everything goes up again
+            capacity = std::max(capacity * 2, data_size);
+            VAO.buffer_instance_data(capacity, NULL, DYNAMIC_DRAW);
+            dirty_begin = 0;
+            dirty_end = instances.size();
+        }
+        if (dirty_begin == dirty_end) return;
+
+        VAO.buffer_instance_sub_data(sizeof(Instance) * dirty_begin, sizeof(Instance) * (dirty_end - dirty_begin), &instances[dirty_begin]);
+        dirty_begin = dirty_end = 0;
+    }
+
+    static void load() {
+        if (program != nullptr) return; // already initialized
+        program = std::make_unique<ShaderProgram>();
+
+        Shader vertex_shader = Shader(VERTEX_SHADER).load_raw(R"(
+            #version 330 core
+            layout (location = 0) in vec2 corner;
+            layout (location = 1) in vec4 placement;  // position, size
+            layout (location = 2) in vec4 transform;  // anchor, rotation, depth
+            layout (location = 3) in vec4 aColor;
+
+            uniform mat4 projection;
+
+            out vec4 vertexColor;
+
+            void main()
+            {
+                vec2 local = (corner - transform.xy) * placement.zw;
+                float s = sin(transform.z), c = cos(transform.z);
+                vec2 rotated = vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+                gl_Position = projection * vec4(placement.xy + rotated, transform.w, 1.0);
+                vertexColor = aColor;
+        })");
+        Shader fragment_shader = Shader(FRAGMENT_SHADER).load_raw(R"(
+            #version 330 core
+            in vec4 vertexColor;
+            out vec4 FragColor;
+
+            void main()
+            {
+                FragColor = vertexColor;
+            }
+        )");
+
+        program->attach_shader(vertex_shader).attach_shader(fragment_shader).link();
+
+        set_automatic_projection(*program, logger, "InstancedQuads");
+    }
+};
+}
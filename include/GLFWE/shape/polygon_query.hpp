@@ -0,0 +1,278 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <limits>
+#include <cstddef>
+
+#if defined(__AVX__)
+#define GLFWE_SHAPE_AVX
+#include <immintrin.h>
+#endif
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define GLFWE_SHAPE_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace GLFWE::Shape {
+/*
+point in convex polygon tests for many points or many polygons at once
+edges are kept as structure of arrays (origin x, origin y, direction x, direction y) so the cross products of
+8 (AVX) or 4 (SSE) points or polygons are computed together, with a scalar loop for the rest and other targets
+a point is inside when every cross product is >= 0 or every one is < 0, the same rule as ConvexPolygon::contains_point
+*/
+struct EdgeArrays {
+    std::vector<float> ax, ay, ex, ey;
+
+    void push_back(glm::vec2 origin, glm::vec2 direction) {
+        ax.push_back(origin.x);
+        ay.push_back(origin.y);
+        ex.push_back(direction.x);
+        ey.push_back(direction.y);
+    }
+    void set(size_t index, glm::vec2 origin, glm::vec2 direction) {
+        ax[index] = origin.x;
+        ay[index] = origin.y;
+        ex[index] = direction.x;
+        ey[index] = direction.y;
+    }
+    size_t size() const {
+        return ax.size();
+    }
+    void clear() {
+        ax.clear();
+        ay.clear();
+        ex.clear();
+        ey.clear();
+    }
+};
+
+// one polygon tested against many points
+class PolygonQuery {
+protected:
+    EdgeArrays edges;
+
+public:
+    PolygonQuery(const std::vector<glm::vec2> & polygon) {
+        set_polygon(polygon);
+    }
+
+    // points in order either clockwise or counterclockwise, nothing is inside polygons with fewer than 3 points
+    void set_polygon(const std::vector<glm::vec2> & polygon) {
+        edges.clear();
+        if (polygon.size() < 3) return;
+        for (size_t i = 0; i < polygon.size(); i++) {
+            glm::vec2 previous = polygon[i == 0 ? polygon.size() - 1 : i - 1];
+            edges.push_back(previous, polygon[i] - previous);
+        }
+    }
+
+    bool contains_point(glm::vec2 point) const {
+        if (edges.size() == 0) return false;
+        bool non_negative = true, negative = true;
+        for (size_t k = 0; k < edges.size(); k++) {
+            float cross = edges.ex[k] * (point.y - edges.ay[k]) - edges.ey[k] * (point.x - edges.ax[k]);
+            non_negative &= cross >= 0;
+            negative &= cross < 0;
+        }
+        return non_negative || negative;
+    }
+
+    // inside[i] is set to 1 when (xs[i], ys[i]) is inside, 0 otherwise
+    void contains_points(const float * xs, const float * ys, size_t count, unsigned char * inside) const {
+        size_t i = 0;
+        if (edges.size() == 0) {
+            for (; i < count; i++) inside[i] = 0;
+            return;
+        }
+
+#ifdef GLFWE_SHAPE_AVX
+        for (; i + 8 <= count; i += 8) {
+            __m256 px = _mm256_loadu_ps(xs + i), py = _mm256_loadu_ps(ys + i);
+            __m256 zero = _mm256_setzero_ps();
+            __m256 non_negative = _mm256_castsi256_ps(_mm256_set1_epi32(-1)), negative = non_negative;
+
+            for (size_t k = 0; k < edges.size(); k++) {
+                __m256 cross = _mm256_sub_ps(
+                    _mm256_mul_ps(_mm256_set1_ps(edges.ex[k]), _mm256_sub_ps(py, _mm256_set1_ps(edges.ay[k]))),
+                    _mm256_mul_ps(_mm256_set1_ps(edges.ey[k]), _mm256_sub_ps(px, _mm256_set1_ps(edges.ax[k]))));
+                non_negative = _mm256_and_ps(non_negative, _mm256_cmp_ps(cross, zero, _CMP_GE_OQ));
+                negative = _mm256_and_ps(negative, _mm256_cmp_ps(cross, zero, _CMP_LT_OQ));
+            }
+
+            int mask = _mm256_movemask_ps(_mm256_or_ps(non_negative, negative));
+            for (int lane = 0; lane < 8; lane++) inside[i + lane] = mask >> lane & 1;
+        }
+#endif
+#ifdef GLFWE_SHAPE_SSE
+        for (; i + 4 <= count; i += 4) {
+            __m128 px = _mm_loadu_ps(xs + i), py = _mm_loadu_ps(ys + i);
+            __m128 zero = _mm_setzero_ps();
+            __m128 non_negative = _mm_cmpeq_ps(zero, zero), negative = non_negative;
+
+            for (size_t k = 0; k < edges.size(); k++) {
+                __m128 cross = _mm_sub_ps(
+                    _mm_mul_ps(_mm_set1_ps(edges.ex[k]), _mm_sub_ps(py, _mm_set1_ps(edges.ay[k]))),
+                    _mm_mul_ps(_mm_set1_ps(edges.ey[k]), _mm_sub_ps(px, _mm_set1_ps(edges.ax[k]))));
+                non_negative = _mm_and_ps(non_negative, _mm_cmpge_ps(cross, zero));
+                negative = _mm_and_ps(negative, _mm_cmplt_ps(cross, zero));
+            }
+
+            int mask = _mm_movemask_ps(_mm_or_ps(non_negative, negative));
+            for (int lane = 0; lane < 4; lane++) inside[i + lane] = mask >> lane & 1;
+        }
+#endif
+        for (; i < count; i++) inside[i] = contains_point({xs[i], ys[i]});
+    }
+
+    void contains_points(const std::vector<glm::vec2> & points, std::vector<unsigned char> & inside) const {
+        inside.resize(points.size());
+
+        // split into structure of arrays a chunk at a time
+        constexpr size_t chunk = 256;
+        float xs[chunk], ys[chunk];
+        for (size_t start = 0; start < points.size(); start += chunk) {
+            size_t count = std::min(chunk, points.size() - start);
+            for (size_t i = 0; i < count; i++) {
+                xs[i] = points[start + i].x;
+                ys[i] = points[start + i].y;
+            }
+            contains_points(xs, ys, count, inside.data() + start);
+        }
+    }
+};
+
+/*
+many polygons tested against one point, e.g. hit testing the cursor against every cell of a grid
+column k holds edge k of every polygon, polygons with fewer edges repeat their last one, which does not change the result
+*/
+class PolygonSet {
+protected:
+    std::vector<EdgeArrays> columns;
+    size_t count = 0;
+
+public:
+    PolygonSet() {}
+
+    PolygonSet(const std::vector<std::vector<glm::vec2>> & polygons) {
+        for (const auto & polygon : polygons) add(polygon);
+    }
+
+    // returns the index of the polygon, nothing is inside polygons with fewer than 3 points
+    size_t add(const std::vector<glm::vec2> & polygon) {
+        if (std::max<size_t>(polygon.size(), 3) > columns.size()) add_columns(std::max<size_t>(polygon.size(), 3));
+        for (EdgeArrays & column : columns) column.push_back({0, 0}, {0, 0});
+        count++;
+        set(count - 1, polygon);
+        return count - 1;
+    }
+
+    // replaces polygon index
+    void set(size_t index, const std::vector<glm::vec2> & polygon) {
+        if (std::max<size_t>(polygon.size(), 3) > columns.size()) add_columns(std::max<size_t>(polygon.size(), 3));
+
+        if (polygon.size() < 3) {
+            // every cross product is NaN, which compares false both ways
+            float nan = std::numeric_limits<float>::quiet_NaN();
+            for (EdgeArrays & column : columns) column.set(index, {nan, nan}, {0, 0});
+            return;
+        }
+
+        for (size_t k = 0; k < columns.size(); k++) {
+            size_t i = std::min(k, polygon.size() - 1);
+            glm::vec2 previous = polygon[i == 0 ? polygon.size() - 1 : i - 1];
+            columns[k].set(index, previous, polygon[i] - previous);
+        }
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    void clear() {
+        columns.clear();
+        count = 0;
+    }
+
+    bool contains_point(size_t index, glm::vec2 point) const {
+        bool non_negative = true, negative = true;
+        for (const EdgeArrays & column : columns) {
+            float cross = column.ex[index] * (point.y - column.ay[index]) - column.ey[index] * (point.x - column.ax[index]);
+            non_negative &= cross >= 0;
+            negative &= cross < 0;
+        }
+        return non_negative || negative;
+    }
+
+    // inside[i] is set to 1 when point is inside polygon i, 0 otherwise, inside must hold size() entries
+    void contains_point(glm::vec2 point, unsigned char * inside) const {
+        for_each_block(point, [&](size_t first, int mask, int lanes) {
+            for (int lane = 0; lane < lanes; lane++) inside[first + lane] = mask >> lane & 1;
+        });
+    }
+
+    // indices of every polygon containing point, in increasing order
+    void find_containing(glm::vec2 point, std::vector<size_t> & hits) const {
+        hits.clear();
+        for_each_block(point, [&](size_t first, int mask, int lanes) {
+            for (int lane = 0; lane < lanes; lane++) if (mask >> lane & 1) hits.push_back(first + lane);
+        });
+    }
+
+protected:
+    // calls func(first, mask, lanes) for consecutive blocks of polygons, bit i of mask set when first + i contains point
+    template<typename Func>
+    void for_each_block(glm::vec2 point, Func func) const {
+        size_t i = 0;
+        if (columns.empty()) return;
+
+#ifdef GLFWE_SHAPE_AVX
+        __m256 px8 = _mm256_set1_ps(point.x), py8 = _mm256_set1_ps(point.y);
+        for (; i + 8 <= count; i += 8) {
+            __m256 zero = _mm256_setzero_ps();
+            __m256 non_negative = _mm256_castsi256_ps(_mm256_set1_epi32(-1)), negative = non_negative;
+
+            for (const EdgeArrays & column : columns) {
+                __m256 cross = _mm256_sub_ps(
+                    _mm256_mul_ps(_mm256_loadu_ps(&column.ex[i]), _mm256_sub_ps(py8, _mm256_loadu_ps(&column.ay[i]))),
+                    _mm256_mul_ps(_mm256_loadu_ps(&column.ey[i]), _mm256_sub_ps(px8, _mm256_loadu_ps(&column.ax[i]))));
+                non_negative = _mm256_and_ps(non_negative, _mm256_cmp_ps(cross, zero, _CMP_GE_OQ));
+                negative = _mm256_and_ps(negative, _mm256_cmp_ps(cross, zero, _CMP_LT_OQ));
+            }
+            func(i, _mm256_movemask_ps(_mm256_or_ps(non_negative, negative)), 8);
+        }
+#endif
+#ifdef GLFWE_SHAPE_SSE
+        __m128 px4 = _mm_set1_ps(point.x), py4 = _mm_set1_ps(point.y);
+        for (; i + 4 <= count; i += 4) {
+            __m128 zero = _mm_setzero_ps();
+            __m128 non_negative = _mm_cmpeq_ps(zero, zero), negative = non_negative;
+
+            for (const EdgeArrays & column : columns) {
+                __m128 cross = _mm_sub_ps(
+                    _mm_mul_ps(_mm_loadu_ps(&column.ex[i]), _mm_sub_ps(py4, _mm_loadu_ps(&column.ay[i]))),
+                    _mm_mul_ps(_mm_loadu_ps(&column.ey[i]), _mm_sub_ps(px4, _mm_loadu_ps(&column.ax[i]))));
+                non_negative = _mm_and_ps(non_negative, _mm_cmpge_ps(cross, zero));
+                negative = _mm_and_ps(negative, _mm_cmplt_ps(cross, zero));
+            }
+            func(i, _mm_movemask_ps(_mm_or_ps(non_negative, negative)), 4);
+        }
+#endif
+        for (; i < count; i++) func(i, contains_point(i, point) ? 1 : 0, 1);
+    }
+
+    // new columns repeat the current last edge of every polygon
+    void add_columns(size_t new_size) {
+        if (columns.empty()) {
+            columns.resize(new_size);
+            for (EdgeArrays & column : columns) {
+                for (size_t i = 0; i < count; i++) column.push_back({0, 0}, {0, 0});
+            }
+            return;
+        }
+        EdgeArrays last = columns.back();
+        columns.resize(new_size, last);
+    }
+};
+}
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <GLFWE/vertex_array.hpp>
+
+#include <GLFWE/shape/shape_shader.hpp>
+
+#include <vector>
+#include <cmath>
+
+#include <logger/logger.hpp>
+
+namespace GLFWE::Shape {
+
+    enum JoinStyle {MITER, BEVEL};
+
+/*
+a line through any number of points, drawn as one triangle strip from one vertex buffer
+thickness is measured from the center line to either edge, the same as Shape::line
+every point owns 4 strip vertices, the edge offsets along the segment before and after it,
+for miter joins all four sit on the miter and a miter longer than miter_limit * thickness falls back to a bevel
+appending a point only rewrites the vertices of the previous point and uploads from there on
+*/
+class Polyline {
+protected:
+    static constexpr Logger logger = Logger("Polyline");
+
+    std::vector<glm::vec2> points;
+    std::vector<glm::vec2> vertices;
+    float thickness;
+    JoinStyle join;
+    float miter_limit;
+
+    GLFWE::VertexArray VAO;
+    unsigned int capacity = 0;   // vertices currently allocated in the vertex buffer
+    size_t first_dirty = 0;      // vertices from here on are not uploaded yet
+
+public:
+    Polyline(float _thickness, JoinStyle _join = MITER, float _miter_limit = 4.0f):
+    thickness(_thickness), join(_join), miter_limit(_miter_limit) {
+        VAO.assign_vertex_attribute(0, 2, GL_FLOAT, GL_FALSE);
+    }
+
+    Polyline(const std::vector<glm::vec2> & _points, float _thickness, JoinStyle _join = MITER, float _miter_limit = 4.0f):
+    Polyline(_thickness, _join, _miter_limit) {
+        append_points(_points);
+    }
+
+    Polyline(Polyline & other) = delete;
+    Polyline(Polyline && other) = default;
+
+    // repeated points are skipped, they have no direction to offset along
+    void append(glm::vec2 point) {
+        if (!points.empty() && points.back() == point) return;
+        points.push_back(point);
+        vertices.resize(points.size() * 4);
+
+        size_t last = points.size() - 1;
+        if (last >= 1) build_point(last - 1);
+        build_point(last);
+        mark_dirty(last >= 1 ? (last - 1) * 4 : 0);
+    }
+    void append_points(const std::vector<glm::vec2> & new_points) {
+        points.reserve(points.size() + new_points.size());
+        vertices.reserve(vertices.size() + new_points.size() * 4);
+        for (glm::vec2 point : new_points) append(point);
+    }
+
+    void set_points(const std::vector<glm::vec2> & new_points) {
+        clear();
+        append_points(new_points);
+    }
+
+    void set_thickness(float new_thickness) {
+        thickness = new_thickness;
+        rebuild();
+    }
+    void set_join(JoinStyle new_join, float new_miter_limit = 4.0f) {
+        join = new_join;
+        miter_limit = new_miter_limit;
+        rebuild();
+    }
+
+    void clear() {
+        points.clear();
+        vertices.clear();
+        first_dirty = 0;
+    }
+
+    const std::vector<glm::vec2> & get_points() {
+        return points;
+    }
+    size_t size() {
+        return points.size();
+    }
+
+    /*
+    draws the line, uploading whatever changed since the last draw
+    color and depth behave as in ConvexPolygon::draw
+    */
+    void draw(glm::vec3 color, float depth) {
+        ShapeShader::set_draw_color(color);
+        ShapeShader::set_draw_depth(depth);
+        draw();
+    }
+    void draw(glm::vec3 color) {
+        ShapeShader::set_draw_color(color);
+        draw();
+    }
+    void draw(float depth) {
+        ShapeShader::set_draw_depth(depth);
+        draw();
+    }
+
+    void draw() {
+        if (points.size() < 2) return;
+        ShapeShader::use();
+        upload();
+        VAO.draw(GL_TRIANGLE_STRIP, vertices.size());
+    }
+
+protected:
+    // unit normal to the left of the segment from a to b
+    static glm::vec2 normal(glm::vec2 a, glm::vec2 b) {
+        glm::vec2 direction = glm::normalize(b - a);
+        return {-direction.y, direction.x};
+    }
+
+    // writes the 4 vertices of point i from its neighbours
+    void build_point(size_t i) {
+        glm::vec2 point = points[i];
+        glm::vec2 * out = &vertices[i * 4];
+
+        if (points.size() < 2) {
+            out[0] = out[1] = out[2] = out[3] = point;
+            return;
+        }
+
+        glm::vec2 normal_in = i > 0 ? normal(points[i - 1], point) : normal(point, points[i + 1]);
+        glm::vec2 normal_out = i + 1 < points.size() ? normal(point, points[i + 1]) : normal_in;
+
+        if (join == MITER) {
+            glm::vec2 sum = normal_in + normal_out;
+            float length = glm::length(sum);
+            if (length > 1e-6f) {
+                glm::vec2 miter = sum / length;
+                float scale = 1.0f / glm::dot(miter, normal_in);
+                if (scale <= miter_limit) {
+                    glm::vec2 offset = miter * (thickness * scale);
+                    out[0] = out[2] = point + offset;
+                    out[1] = out[3] = point - offset;
+                    return;
+                }
+            }
+        }
+
+        // bevel, the two triangles between the pairs fill the corner on the outer side
+        out[0] = point + normal_in * thickness;
+        out[1] = point - normal_in * thickness;
+        out[2] = point + normal_out * thickness;
+        out[3] = point - normal_out * thickness;
+    }
+
+    void rebuild() {
+        for (size_t i = 0; i < points.size(); i++) build_point(i);
+        mark_dirty(0);
+    }
+
+    void mark_dirty(size_t first_vertex) {
+        first_dirty = std::min(first_dirty, first_vertex);
+    }
+
+    void upload() {
+        if (vertices.size() > capacity) {
+            // the new storage starts empty, so everything goes up again
+            capacity = std::max<unsigned int>(capacity * 2, vertices.size());
+            VAO.buffer_vertex_data(sizeof(glm::vec2) * capacity, NULL, DYNAMIC_DRAW);
+            first_dirty = 0;
+        }
+        if (first_dirty >= vertices.size()) return;
+
+        VAO.buffer_vertex_sub_data(sizeof(glm::vec2) * first_dirty, sizeof(glm::vec2) * (vertices.size() - first_dirty), &vertices[first_dirty]);
+        first_dirty = vertices.size();
+    }
+};
+}
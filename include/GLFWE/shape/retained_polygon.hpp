@@ -0,0 +1,160 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <GLFWE/vertex_array.hpp>
+#include <GLFWE/range_allocator.hpp>
+
+#include <GLFWE/shape/shape_shader.hpp>
+#include <GLFWE/shape/convex_polygon.hpp>
+
+#include <vector>
+#include <memory>
+
+#include <logger/logger.hpp>
+
+namespace GLFWE::Shape {
+/*
+a convex polygon whose vertices stay on the gpu between frames
+every retained polygon owns a slice of one shared vertex buffer and only uploads it after its points changed,
+so static polygons cost no upload bandwidth after their first draw
+points can only be changed through set_points, set_point or edit, which is how changes are noticed
+*/
+class RetainedPolygon {
+protected:
+    static constexpr Logger logger = Logger("Retained Polygon");
+
+    ConvexPolygon points;
+    unsigned int first_vertex = 0;
+    unsigned int allocated = 0; // vertices owned in the shared buffer
+    bool dirty = true;
+
+    // shared vertex storage, in vertices
+    static std::unique_ptr<VertexArray> VAO;
+    static RangeAllocator allocator;
+
+public:
+    RetainedPolygon(const std::vector<glm::vec2> & _points):
+    points(_points.begin(), _points.end()) {}
+
+    RetainedPolygon(RetainedPolygon & other) = delete;
+    RetainedPolygon(RetainedPolygon && other):
+    points(std::move(other.points)), first_vertex(other.first_vertex), allocated(other.allocated), dirty(other.dirty) {
+        other.allocated = 0;
+    }
+
+    ~RetainedPolygon() {
+        destroy();
+    }
+
+    // gives the slice back to the shared buffer
+    void destroy() {
+        if (allocated) allocator.free(first_vertex, allocated);
+        allocated = 0;
+        dirty = true;
+    }
+
+    void set_points(const std::vector<glm::vec2> & new_points) {
+        points.assign(new_points.begin(), new_points.end());
+        dirty = true;
+    }
+    void set_point(size_t index, glm::vec2 point) {
+        if (points[index] == point) return;
+        points[index] = point;
+        dirty = true;
+    }
+
+    // direct access to the points, assumes they are changed
+    ConvexPolygon & edit() {
+        dirty = true;
+        return points;
+    }
+
+    const ConvexPolygon & get_points() const {
+        return points;
+    }
+    size_t size() const {
+        return points.size();
+    }
+    bool contains_point(glm::vec2 point) {
+        return points.contains_point(point);
+    }
+
+    /*
+    draws the polygon, uploading its points first if they changed since the last draw
+    color and depth behave as in ConvexPolygon::draw
+    */
+    void draw(glm::vec3 color, float depth) {
+        ShapeShader::set_draw_color(color);
+        ShapeShader::set_draw_depth(depth);
+        draw();
+    }
+    void draw(glm::vec3 color) {
+        ShapeShader::set_draw_color(color);
+        draw();
+    }
+    void draw(float depth) {
+        ShapeShader::set_draw_depth(depth);
+        draw();
+    }
+
+    void draw() {
+        if (points.size() < 3) return;
+        ShapeShader::use();
+        if (dirty) upload();
+        VAO->draw(GL_TRIANGLE_FAN, points.size(), first_vertex);
+    }
+
+    // vertices allocated in the shared buffer by every live polygon
+    static unsigned int get_pool_used() {
+        return allocator.get_used();
+    }
+    static unsigned int get_pool_capacity() {
+        return allocator.get_capacity();
+    }
+
+protected:
+    void upload() {
+        if (VAO == nullptr) init_vao();
+
+        // a slice is only moved when the polygon no longer fits in it
+        if (allocated != points.size()) {
+            if (allocated) allocator.free(first_vertex, allocated);
+            allocated = points.size();
+            if (!allocator.allocate(allocated, first_vertex)) {
+                grow(allocated);
+                allocator.allocate(allocated, first_vertex);
+            }
+        }
+
+        VAO->buffer_vertex_sub_data(sizeof(glm::vec2) * first_vertex, sizeof(glm::vec2) * points.size(), points.data());
+        dirty = false;
+    }
+
+    static void init_vao() {
+        VAO = std::make_unique<GLFWE::VertexArray>();
+        allocator.reset(1024);
+        VAO->buffer_vertex_data(sizeof(glm::vec2) * allocator.get_capacity(), NULL, DYNAMIC_DRAW);
+        VAO->assign_vertex_attribute(0, 2, GL_FLOAT, GL_FALSE);
+    }
+
+    // moves every slice into a larger buffer with a gpu side copy, offsets stay the same
+    static void grow(unsigned int required) {
+        unsigned int old_capacity = allocator.get_capacity();
+        unsigned int capacity = std::max(old_capacity * 2, old_capacity + required);
+
+        auto grown = std::make_unique<GLFWE::VertexArray>();
+        grown->buffer_vertex_data(sizeof(glm::vec2) * capacity, NULL, DYNAMIC_DRAW);
+        grown->assign_vertex_attribute(0, 2, GL_FLOAT, GL_FALSE);
+
+        // the copy targets are left out of Buffer's binding cache, which only follows ARRAY_BUFFER
+        glBindBuffer(GL_COPY_READ_BUFFER, VAO->get_buffer().id());
+        glBindBuffer(GL_COPY_WRITE_BUFFER, grown->get_buffer().id());
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, sizeof(glm::vec2) * old_capacity);
+
+        VAO = std::move(grown);
+        allocator.grow(capacity);
+        logger << "Shared vertex buffer grown to " << capacity << " vertices";
+    }
+};
+}
@@ -15,6 +15,23 @@
 #include <logger/logger.hpp>
 
 namespace GLFWE::Shape {
+// screen space projection of every shape shader, one unit per pixel with the origin in the bottom left corner
+inline void set_program_projection(ShaderProgram & program, glm::vec2 projection) {
+    program.use();
+    glm::mat4 projection_matrix = glm::ortho(0.0f, projection.x, 0.0f, projection.y);
+    glUniformMatrix4fv(program.get_uniform_location("projection"), 1, GL_FALSE, glm::value_ptr(projection_matrix));
+}
+
+// called once a shape shader is linked, uses the size of the window when there is only one
+inline void set_automatic_projection(ShaderProgram & program, const Logger & logger, const char * name) {
+    if (!Window::has_only_one_instance()) logger.log(Logger::WARNING) << "Multiple window instances detected. Please manually declare the projection for GLFWE/Shape/" << name;
+    else {
+        glm::vec2 proj_size = Window::get_single_instance_size();
+        logger << "Automatically configuring projection for " << name << " to: (" << proj_size.x << ", " << proj_size.y << ")";
+        set_program_projection(program, proj_size);
+    }
+}
+
 class ShapeShader {
 protected:
     static constexpr Logger logger = Logger("Shape Shader");
@@ -48,9 +65,8 @@ public:
     }
 
     static void set_projection(glm::vec2 projection) {
-        use();
-        glm::mat4 projection_matrix = glm::ortho(0.0f, projection.x, 0.0f, projection.y);
-        glUniformMatrix4fv(program->get_uniform_location("projection"), 1, GL_FALSE, glm::value_ptr(projection_matrix));
+        load();
+        set_program_projection(*program, projection);
     }
 
     static void pre_load() {
@@ -94,12 +110,7 @@ protected:
         glUniform4f(program->get_uniform_location("color"), 0, 0, 0, 1); 
 
         // automatically set projection if possible
-        if (!Window::has_only_one_instance()) logger.log(Logger::WARNING) << "Multiple window instances detected. Please manually decalre the projection for GLFWE/Shape/ShapeShader";
-        else {
-            glm::vec2 proj_size = Window::get_single_instance_size();
-            logger << "Automatically configuring projection for ShapeShader to: (" << proj_size.x << ", " << proj_size.y << ")";
-            set_projection(proj_size);
-        }
+        set_automatic_projection(*program, logger, "ShapeShader");
     }
 };
 }
\ No newline at end of file
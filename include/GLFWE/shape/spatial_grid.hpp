@@ -0,0 +1,348 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <GLFWE/shape/convex_polygon.hpp>
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+
+#include <logger/logger.hpp>
+
+namespace GLFWE::Shape {
+/*
+uniform grid over convex polygons for hover detection, rectangle selection and nearest shape queries
+every polygon is listed in each cell its bounding box touches, so queries only look at the shapes near them
+cells are hashed, the grid has no fixed extent
+pick a cell size around the size of a typical shape, much smaller makes large shapes expensive to move
+*/
+class SpatialGrid {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+protected:
+    static constexpr Logger logger = Logger("Spatial Grid");
+
+    struct Entry {
+        ConvexPolygon polygon;
+        glm::vec2 low, high;         // bounding box
+        glm::ivec2 cell_low, cell_high; // cells the bounding box touches, inclusive
+        bool alive = false;
+    };
+
+    float cell_size;
+    std::vector<Entry> entries;     // indexed by id
+    std::vector<size_t> free_ids;   // ids of removed entries, reused by insert
+    std::unordered_map<uint64_t, std::vector<size_t>> cells;
+    size_t count = 0;
+
+    // cells holding shapes, bounds the nearest search
+    // a shape leaving the edge of the bounds only marks them stale, nearest() recomputes them from the live entries
+    glm::ivec2 occupied_low = glm::ivec2(std::numeric_limits<int>::max());
+    glm::ivec2 occupied_high = glm::ivec2(std::numeric_limits<int>::min());
+    bool occupied_stale = false;
+
+    // entries seen by the current query, so shapes spanning several cells are reported once
+    std::vector<unsigned int> visited;
+    unsigned int query_stamp = 0;
+
+public:
+    SpatialGrid(float _cell_size = 64.0f):
+    cell_size(_cell_size) {}
+
+    // returns the id used to update, remove and identify the polygon in query results
+    size_t insert(const ConvexPolygon & polygon) {
+        size_t id;
+        if (!free_ids.empty()) {
+            id = free_ids.back();
+            free_ids.pop_back();
+        } else {
+            id = entries.size();
+            entries.emplace_back();
+            visited.push_back(0);
+        }
+
+        Entry & entry = entries[id];
+        entry.polygon = polygon;
+        entry.alive = true;
+        compute_bounds(entry);
+        add_to_cells(id);
+        count++;
+        return id;
+    }
+
+    // replaces the polygon of id, only cells it left or entered are touched
+    void update(size_t id, const ConvexPolygon & polygon) {
+        Entry & entry = entries[id];
+        if (!entry.alive) {
+            logger.log(Logger::WARNING) << "Ignoring update of removed shape " << id;
+            return;
+        }
+        glm::ivec2 old_low = entry.cell_low, old_high = entry.cell_high;
+        entry.polygon = polygon;
+        compute_bounds(entry);
+        if (entry.cell_low == old_low && entry.cell_high == old_high) return;
+
+        glm::ivec2 new_low = entry.cell_low, new_high = entry.cell_high;
+        for (int y = old_low.y; y <= old_high.y; y++) {
+            for (int x = old_low.x; x <= old_high.x; x++) {
+                if (!inside_cells(x, y, new_low, new_high)) remove_from_cell(x, y, id);
+            }
+        }
+        for (int y = new_low.y; y <= new_high.y; y++) {
+            for (int x = new_low.x; x <= new_high.x; x++) {
+                if (!inside_cells(x, y, old_low, old_high)) cells[key(x, y)].push_back(id);
+            }
+        }
+        leave_occupied(old_low, old_high);
+        grow_occupied(new_low, new_high);
+    }
+
+    void remove(size_t id) {
+        Entry & entry = entries[id];
+        if (!entry.alive) return;
+        for (int y = entry.cell_low.y; y <= entry.cell_high.y; y++) {
+            for (int x = entry.cell_low.x; x <= entry.cell_high.x; x++) remove_from_cell(x, y, id);
+        }
+        leave_occupied(entry.cell_low, entry.cell_high);
+        entry.alive = false;
+        entry.polygon.clear();
+        free_ids.push_back(id);
+        count--;
+    }
+
+    void clear() {
+        entries.clear();
+        free_ids.clear();
+        cells.clear();
+        visited.clear();
+        count = 0;
+        occupied_low = glm::ivec2(std::numeric_limits<int>::max());
+        occupied_high = glm::ivec2(std::numeric_limits<int>::min());
+        occupied_stale = false;
+    }
+
+    const ConvexPolygon & get(size_t id) {
+        return entries[id].polygon;
+    }
+    size_t size() {
+        return count;
+    }
+
+    // ids of every polygon containing point
+    void query_point(glm::vec2 point, std::vector<size_t> & hits) {
+        hits.clear();
+        auto cell = cells.find(key(cell_of(point.x), cell_of(point.y)));
+        if (cell == cells.end()) return;
+
+        // a single cell lists every shape at most once
+        for (size_t id : cell->second) {
+            if (hit(entries[id], point)) hits.push_back(id);
+        }
+    }
+
+    // first polygon found containing point, npos if there is none
+    size_t find_at(glm::vec2 point) {
+        auto cell = cells.find(key(cell_of(point.x), cell_of(point.y)));
+        if (cell == cells.end()) return npos;
+
+        for (size_t id : cell->second) {
+            if (hit(entries[id], point)) return id;
+        }
+        return npos;
+    }
+
+    // ids of every polygon overlapping the axis aligned rectangle between low and high
+    void query_rect(glm::vec2 low, glm::vec2 high, std::vector<size_t> & hits) {
+        hits.clear();
+        glm::vec2 rect_low = glm::min(low, high), rect_high = glm::max(low, high);
+        next_query();
+
+        int x0 = cell_of(rect_low.x), x1 = cell_of(rect_high.x);
+        int y0 = cell_of(rect_low.y), y1 = cell_of(rect_high.y);
+        for (int y = y0; y <= y1; y++) {
+            for (int x = x0; x <= x1; x++) {
+                auto cell = cells.find(key(x, y));
+                if (cell == cells.end()) continue;
+
+                for (size_t id : cell->second) {
+                    if (visited[id] == query_stamp) continue;
+                    visited[id] = query_stamp;
+                    const Entry & entry = entries[id];
+                    if (entry.high.x < rect_low.x || entry.high.y < rect_low.y || entry.low.x > rect_high.x || entry.low.y > rect_high.y) continue;
+                    if (overlaps_rect(entry.polygon, rect_low, rect_high)) hits.push_back(id);
+                }
+            }
+        }
+    }
+
+    /*
+    the polygon closest to point, 0 away if point is inside it, npos if none lies within max_distance
+    cells are searched in rings around point until no unvisited cell can hold anything closer
+    */
+    size_t nearest(glm::vec2 point, float max_distance = std::numeric_limits<float>::infinity(), float * distance = nullptr) {
+        size_t best = npos;
+        float best_distance = max_distance;
+        if (count == 0) return npos;
+        if (occupied_stale) recompute_occupied();
+        next_query();
+
+        int cx = cell_of(point.x), cy = cell_of(point.y);
+        int max_ring = std::max({cx - occupied_low.x, occupied_high.x - cx, cy - occupied_low.y, occupied_high.y - cy, 0});
+        if (std::isfinite(max_distance)) max_ring = std::min(max_ring, (int) std::ceil(max_distance / cell_size) + 1);
+
+        for (int ring = 0; ring <= max_ring; ring++) {
+            for (int y = cy - ring; y <= cy + ring; y++) {
+                // the whole row on the top and bottom of the ring, only the two ends otherwise
+                int step = y == cy - ring || y == cy + ring ? 1 : std::max(2 * ring, 1);
+                for (int x = cx - ring; x <= cx + ring; x += step) {
+                    auto cell = cells.find(key(x, y));
+                    if (cell == cells.end()) continue;
+
+                    for (size_t id : cell->second) {
+                        if (visited[id] == query_stamp) continue;
+                        visited[id] = query_stamp;
+                        float d = distance_to(entries[id].polygon, point);
+                        if (d < best_distance || (best == npos && d <= best_distance)) {
+                            best_distance = d;
+                            best = id;
+                        }
+                    }
+                }
+            }
+            // shapes not seen yet only touch cells of later rings, at least ring cells away
+            if (best != npos && best_distance <= ring * cell_size) break;
+        }
+
+        if (distance && best != npos) *distance = best_distance;
+        return best;
+    }
+
+    // distance from point to the polygon, 0 inside it
+    static float distance_to(const ConvexPolygon & polygon, glm::vec2 point) {
+        if (polygon.contains_point(point)) return 0;
+
+        float best = std::numeric_limits<float>::infinity();
+        for (size_t i = 0; i < polygon.size(); i++) {
+            glm::vec2 a = polygon[i == 0 ? polygon.size() - 1 : i - 1], b = polygon[i];
+            glm::vec2 edge = b - a;
+            float length = glm::dot(edge, edge);
+            float t = length > 0 ? glm::clamp(glm::dot(point - a, edge) / length, 0.0f, 1.0f) : 0.0f;
+            best = std::min(best, glm::length(point - (a + edge * t)));
+        }
+        return best;
+    }
+
+    // separating axis test between a convex polygon and an axis aligned rectangle
+    static bool overlaps_rect(const ConvexPolygon & polygon, glm::vec2 low, glm::vec2 high) {
+        if (polygon.empty()) return false;
+
+        // the rectangle's own axes are the bounding box test, left to the caller
+        glm::vec2 corners[4] = {low, {high.x, low.y}, high, {low.x, high.y}};
+        for (size_t i = 0; i < polygon.size(); i++) {
+            glm::vec2 a = polygon[i == 0 ? polygon.size() - 1 : i - 1], b = polygon[i];
+            glm::vec2 axis(a.y - b.y, b.x - a.x);
+
+            float polygon_min = std::numeric_limits<float>::infinity(), polygon_max = -polygon_min;
+            for (glm::vec2 point : polygon) {
+                float projection = glm::dot(point, axis);
+                polygon_min = std::min(polygon_min, projection);
+                polygon_max = std::max(polygon_max, projection);
+            }
+            float rect_min = std::numeric_limits<float>::infinity(), rect_max = -rect_min;
+            for (glm::vec2 corner : corners) {
+                float projection = glm::dot(corner, axis);
+                rect_min = std::min(rect_min, projection);
+                rect_max = std::max(rect_max, projection);
+            }
+            if (polygon_max < rect_min || rect_max < polygon_min) return false;
+        }
+        return true;
+    }
+
+protected:
+    int cell_of(float coordinate) {
+        return (int) std::floor(coordinate / cell_size);
+    }
+
+    static uint64_t key(int x, int y) {
+        return (uint64_t)(uint32_t) x << 32 | (uint32_t) y;
+    }
+
+    static bool inside_cells(int x, int y, glm::ivec2 low, glm::ivec2 high) {
+        return x >= low.x && x <= high.x && y >= low.y && y <= high.y;
+    }
+
+    static bool hit(const Entry & entry, glm::vec2 point) {
+        if (point.x < entry.low.x || point.y < entry.low.y || point.x > entry.high.x || point.y > entry.high.y) return false;
+        return entry.polygon.contains_point(point);
+    }
+
+    void compute_bounds(Entry & entry) {
+        if (entry.polygon.empty()) {
+            entry.low = entry.high = glm::vec2(0.0f);
+        } else {
+            entry.low = entry.high = entry.polygon[0];
+            for (glm::vec2 point : entry.polygon) {
+                entry.low = glm::min(entry.low, point);
+                entry.high = glm::max(entry.high, point);
+            }
+        }
+        entry.cell_low = glm::ivec2(cell_of(entry.low.x), cell_of(entry.low.y));
+        entry.cell_high = glm::ivec2(cell_of(entry.high.x), cell_of(entry.high.y));
+    }
+
+    void add_to_cells(size_t id) {
+        Entry & entry = entries[id];
+        for (int y = entry.cell_low.y; y <= entry.cell_high.y; y++) {
+            for (int x = entry.cell_low.x; x <= entry.cell_high.x; x++) cells[key(x, y)].push_back(id);
+        }
+        grow_occupied(entry.cell_low, entry.cell_high);
+    }
+
+    void remove_from_cell(int x, int y, size_t id) {
+        auto cell = cells.find(key(x, y));
+        if (cell == cells.end()) return;
+
+        std::vector<size_t> & ids = cell->second;
+        for (size_t i = 0; i < ids.size(); i++) {
+            if (ids[i] != id) continue;
+            ids[i] = ids.back();
+            ids.pop_back();
+            break;
+        }
+        if (ids.empty()) cells.erase(cell);
+    }
+
+    void grow_occupied(glm::ivec2 low, glm::ivec2 high) {
+        occupied_low = glm::min(occupied_low, low);
+        occupied_high = glm::max(occupied_high, high);
+    }
+
+    // cells between low and high no longer hold the shape, the bounds only change if they were on their edge
+    void leave_occupied(glm::ivec2 low, glm::ivec2 high) {
+        if (low.x == occupied_low.x || low.y == occupied_low.y || high.x == occupied_high.x || high.y == occupied_high.y) occupied_stale = true;
+    }
+
+    void recompute_occupied() {
+        occupied_low = glm::ivec2(std::numeric_limits<int>::max());
+        occupied_high = glm::ivec2(std::numeric_limits<int>::min());
+        for (const Entry & entry : entries) {
+            if (entry.alive) grow_occupied(entry.cell_low, entry.cell_high);
+        }
+        occupied_stale = false;
+    }
+
+    void next_query() {
+        if (++query_stamp == 0) {
+            // wrapped around, old marks could collide with new stamps
+            std::fill(visited.begin(), visited.end(), 0);
+            query_stamp = 1;
+        }
+    }
+};
+}
@@ -4,11 +4,16 @@
 #include <GLFWE/shader_program.hpp>
 #include <GLFWE/texture.hpp>
 #include <GLFWE/vertex_array.hpp>
+#include <GLFWE/framebuffer.hpp>
 
 #include <GLFWE/text/character_set.hpp>
+#include <GLFWE/text/text_impostor.hpp>
 
 #include <GLFWE/shape/shape_shader.hpp>
 #include <GLFWE/shape/convex_polygon.hpp>
+#include <GLFWE/shape/batch.hpp>
+#include <GLFWE/shape/retained_polygon.hpp>
+#include <GLFWE/shape/instanced_quads.hpp>
 
 using namespace GLFWE;
 
@@ -23,12 +28,30 @@ unsigned int Buffer::current_bound = 0;
 unsigned int ShaderProgram::current_bound = 0;
 unsigned int Texture::current_bound = 0;
 unsigned int VertexArray::current_bound = 0;
+unsigned int Framebuffer::current_bound = 0;
+
+// fonts
+FT_Library Text::FontManager::library = nullptr;
+std::unordered_map<std::string, std::unique_ptr<Text::FontFile>> Text::FontManager::files;
 
 // text vao and program
 std::unique_ptr<VertexArray> Text::CharacterSet::VAO;
+unsigned int Text::CharacterSet::VAO_capacity = sizeof(Text::GlyphVertex) * 6 * 64;
 std::unique_ptr<ShaderProgram> Text::CharacterSet::program;
+std::unique_ptr<VertexArray> Text::CharacterSet::instanced_VAO;
+unsigned int Text::CharacterSet::instanced_VAO_capacity = sizeof(Text::GlyphInstance) * 256;
+std::unique_ptr<ShaderProgram> Text::CharacterSet::instanced_program;
+glm::vec2 Text::CharacterSet::projection_size = glm::vec2(0.0f);
+
+// text impostor quad and program
+std::unique_ptr<VertexArray> Text::TextImpostor::VAO;
+std::unique_ptr<ShaderProgram> Text::TextImpostor::program;
 
 // shapes
 std::unique_ptr<ShaderProgram> Shape::ShapeShader::program;
 
-std::unique_ptr<VertexArray> Shape::ConvexPolygon::VAO;
\ No newline at end of file
+std::unique_ptr<VertexArray> Shape::ConvexPolygon::VAO;
+std::unique_ptr<ShaderProgram> Shape::Batch::program;
+std::unique_ptr<VertexArray> Shape::RetainedPolygon::VAO;
+RangeAllocator Shape::RetainedPolygon::allocator;
+std::unique_ptr<ShaderProgram> Shape::InstancedQuads::program;
\ No newline at end of file
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <GLFWE/mapped_file.hpp>
+
+#include <stb/stb_image.h>
+
+#include <logger/logger.hpp>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+
+namespace GLFWE::Text {
+/*
+description of an AngelCode BMFont (.fnt, text or binary format) whose glyphs were baked ahead of time
+only the metadata is read here, pages are decoded by load_page() when a CharacterSet is built from it
+*/
+class BMFont {
+protected:
+    static constexpr Logger logger = Logger("BMFont");
+
+public:
+    struct Glyph {
+        uint32_t id;
+        int x, y, width, height; // texels of the glyph on its page
+        int x_offset, y_offset;  // from the pen (at the top of the line) to the top left of the glyph
+        int x_advance;
+        unsigned int page;
+        unsigned int channel;    // bit mask, 1 blue, 2 green, 4 red, 8 alpha
+    };
+
+    struct KerningPair {
+        uint32_t first, second;
+        int amount;
+    };
+
+    std::filesystem::path path;
+    int size = 0;        // height the font was baked at
+    int line_height = 0; // distance between baselines
+    int base = 0;        // distance from the top of a line to the baseline
+    bool packed = false; // glyphs are spread over the color channels of the pages
+    std::vector<std::filesystem::path> pages;
+    std::vector<Glyph> glyphs;
+    std::vector<KerningPair> kerning_pairs;
+
+    BMFont(const std::filesystem::path & _path):
+    path(_path) {
+        MappedFile file(path);
+        if (!file.is_open()) {
+            logger.log(Logger::CRITICAL) << "ERROR: Failed to open BMFont file: " << path.c_str();
+            return;
+        }
+
+        bool parsed = file.size() >= 4 && std::memcmp(file.data(), "BMF", 3) == 0
+            ? parse_binary(file.data(), file.size())
+            : parse_text(std::string((const char *) file.data(), file.size()));
+        if (!parsed || pages.empty()) {
+            logger.log(Logger::CRITICAL) << "ERROR: Failed to parse BMFont file: " << path.c_str();
+            glyphs.clear();
+            pages.clear();
+        }
+    }
+
+    bool is_open() const {
+        return !pages.empty();
+    }
+
+    // decodes page index, texels keeps the channels of the image file interleaved
+    bool load_page(unsigned int index, std::vector<unsigned char> & texels, int & width, int & height, int & channels) const {
+        // glyph rectangles are measured from the top row, Texture::buffer_image_from_path leaves flipping on
+        stbi_set_flip_vertically_on_load(false);
+        unsigned char * image = stbi_load(pages[index].c_str(), &width, &height, &channels, 0);
+        if (!image) {
+            logger.log(Logger::CRITICAL) << "ERROR: Failed to decode BMFont page " << pages[index].c_str() << ": " << stbi_failure_reason();
+            return false;
+        }
+        texels.assign(image, image + (size_t) width * height * channels);
+        stbi_image_free(image);
+        return true;
+    }
+
+    /*
+    which of the interleaved channels of a page holds the coverage of glyph
+    the alpha channel when the image has one, the glyph's own channel for packed fonts, otherwise the first one
+    */
+    int coverage_channel(const Glyph & glyph, int channels) const {
+        if (channels == 4 && packed) {
+            if (glyph.channel & 8) return 3;
+            if (glyph.channel & 4) return 0;
+            if (glyph.channel & 2) return 1;
+            if (glyph.channel & 1) return 2;
+        }
+        return channels == 4 || channels == 2 ? channels - 1 : 0;
+    }
+
+protected:
+    // value of key=value in a line of the text format, quotes are stripped
+    static bool find_value(const std::string & line, const char * key, std::string & value) {
+        std::string pattern = std::string(" ") + key + "=";
+        size_t start = line.find(pattern);
+        if (start == std::string::npos) return false;
+        start += pattern.size();
+
+        size_t end;
+        if (start < line.size() && line[start] == '"') {
+            end = line.find('"', ++start);
+            if (end == std::string::npos) end = line.size();
+        } else {
+            end = line.find_first_of(" \t\r", start);
+            if (end == std::string::npos) end = line.size();
+        }
+        value = line.substr(start, end - start);
+        return true;
+    }
+
+    static int find_int(const std::string & line, const char * key) {
+        std::string value;
+        return find_value(line, key, value) ? std::atoi(value.c_str()) : 0;
+    }
+
+    bool parse_text(const std::string & text) {
+        size_t line_start = 0;
+        while (line_start < text.size()) {
+            size_t line_end = text.find('\n', line_start);
+            if (line_end == std::string::npos) line_end = text.size();
+            std::string line = text.substr(line_start, line_end - line_start);
+            line_start = line_end + 1;
+
+            std::string tag = line.substr(0, line.find(' '));
+            if (tag == "info") {
+                size = std::abs(find_int(line, "size"));
+            } else if (tag == "common") {
+                line_height = find_int(line, "lineHeight");
+                base = find_int(line, "base");
+                packed = find_int(line, "packed");
+            } else if (tag == "page") {
+                std::string file;
+                unsigned int id = find_int(line, "id");
+                if (!find_value(line, "file", file) || id > 255) return false;
+                if (pages.size() <= id) pages.resize(id + 1);
+                pages[id] = path.parent_path() / file;
+            } else if (tag == "char") {
+                glyphs.push_back({
+                    (uint32_t) find_int(line, "id"),
+                    find_int(line, "x"), find_int(line, "y"), find_int(line, "width"), find_int(line, "height"),
+                    find_int(line, "xoffset"), find_int(line, "yoffset"), find_int(line, "xadvance"),
+                    (unsigned int) find_int(line, "page"), (unsigned int) find_int(line, "chnl")
+                });
+            } else if (tag == "kerning") {
+                kerning_pairs.push_back({(uint32_t) find_int(line, "first"), (uint32_t) find_int(line, "second"), find_int(line, "amount")});
+            }
+        }
+        return true;
+    }
+
+    // little endian reads of the binary format
+    static uint32_t read_u32(const unsigned char * data) { return data[0] | data[1] << 8 | data[2] << 16 | (uint32_t) data[3] << 24; }
+    static uint16_t read_u16(const unsigned char * data) { return data[0] | data[1] << 8; }
+    static int16_t read_i16(const unsigned char * data) { return (int16_t) read_u16(data); }
+
+    bool parse_binary(const unsigned char * data, size_t data_size) {
+        if (data[3] != 3) {
+            logger.log(Logger::WARNING) << "Unsupported binary BMFont version " << (int) data[3];
+            return false;
+        }
+
+        size_t offset = 4;
+        while (offset + 5 <= data_size) {
+            unsigned char type = data[offset];
+            uint32_t block_size = read_u32(data + offset + 1);
+            const unsigned char * block = data + offset + 5;
+            offset += 5;
+            if (block_size > data_size - offset) return false;
+            offset += block_size;
+
+            if (type == 1 && block_size >= 2) {
+                size = std::abs(read_i16(block));
+            } else if (type == 2 && block_size >= 15) {
+                line_height = read_u16(block);
+                base = read_u16(block + 2);
+                packed = block[10] & 0x80; // bit 7 of the bit field
+            } else if (type == 3) {
+                // null terminated file names
+                for (size_t i = 0; i < block_size;) {
+                    size_t length = strnlen((const char *) block + i, block_size - i);
+                    pages.push_back(path.parent_path() / std::string((const char *) block + i, length));
+                    i += length + 1;
+                }
+            } else if (type == 4) {
+                for (size_t i = 0; i + 20 <= block_size; i += 20) {
+                    const unsigned char * c = block + i;
+                    glyphs.push_back({
+                        read_u32(c),
+                        read_u16(c + 4), read_u16(c + 6), read_u16(c + 8), read_u16(c + 10),
+                        read_i16(c + 12), read_i16(c + 14), read_i16(c + 16),
+                        c[18], c[19]
+                    });
+                }
+            } else if (type == 5) {
+                for (size_t i = 0; i + 10 <= block_size; i += 10) {
+                    kerning_pairs.push_back({read_u32(block + i), read_u32(block + i + 4), read_i16(block + i + 8)});
+                }
+            }
+        }
+        return true;
+    }
+};
+}
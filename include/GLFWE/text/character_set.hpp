@@ -13,110 +13,775 @@
 #include <GLFWE/shader.hpp>
 #include <GLFWE/shader_program.hpp>
 
+#include <GLFWE/mapped_file.hpp>
+
+#include <GLFWE/text/bmfont.hpp>
+#include <GLFWE/text/font_manager.hpp>
+#include <GLFWE/text/glyph_atlas.hpp>
+#include <GLFWE/text/glyph_cache.hpp>
+#include <GLFWE/text/glyph_quad.hpp>
+#include <GLFWE/text/kerning_table.hpp>
+#include <GLFWE/text/text_layout.hpp>
+#include <GLFWE/text/utf8.hpp>
+
 #include <logger/logger.hpp>
 
 #include <filesystem>
+#include <fstream>
 #include <memory>
-#include <map>
+#include <vector>
+#include <array>
+#include <unordered_map>
+#include <algorithm>
+#include <thread>
+#include <functional>
+#include <cstddef>
 
 namespace GLFWE::Text {
+// per glyph attributes of the instanced text path, drawn over a shared unit quad
+struct GlyphInstance {
+    glm::vec4    rect;  // screen space left, bottom, width, height
+    glm::vec4    uv;    // atlas texels left, top, right, bottom
+    unsigned int color; // rgba8
+};
+
+// a glyph at scale 1, relative to the pen, for callers that place glyphs themselves
+struct GlyphQuad {
+    glm::vec4 quad;    // left, bottom, right, top, as passed to write_glyph_quad
+    glm::vec4 texels;  // atlas texels left, top, right, bottom
+    float     advance; // in pixels
+};
+
+// a run of vertices in a vertex array, drawn moved by offset
+struct VertexRange {
+    unsigned int first;
+    unsigned int count;
+    glm::vec2    offset;
+};
+
 class CharacterSet {
 protected:
     static constexpr Logger logger = Logger("Text");
 
+    enum GlyphState : unsigned char {
+        UNLOADED, // not rasterized yet, or evicted from the atlas
+        RESIDENT, // rasterized and packed in the atlas
+        MISSING,  // not in the font, the fallback glyph is drawn instead
+        DEFERRED  // the atlas had no room, drawn as the fallback until the next use of the atlas
+    };
+
     struct Character {
-        GLFWE::Texture texture; 
         glm::ivec2  size;        // Size of glyph
         glm::ivec2  bearing;     // Offset from baseline to left/top of glyph
         signed long advance;     // Offset to advance to next glyph
+        glm::ivec4  uv;          // Texel rectangle of glyph in the atlas (left, top, right, bottom)
+        unsigned int shelf;      // Atlas shelf holding the glyph
+        GlyphState state = UNLOADED;
+        unsigned int deferred_use; // use of the atlas that had no room for the glyph, while DEFERRED
+
+        // precomputed for write_glyph_quad
+        glm::vec4   quad;        // left, bottom, right, top at scale 1, relative to the pen
+        glm::vec4   texels;      // uv as floats
+
+        void prepare_quad() {
+            quad = glm::vec4(bearing.x, bearing.y - size.y, bearing.x + size.x, bearing.y);
+            texels = glm::vec4(uv);
+        }
     };
     
-    std::map<char, Character> characters;
+    // glyphs are rasterized the first time they are looked up
+    std::vector<Character> characters;                       // codes in [lower_ascii, upper_ascii), indexed by code - lower_ascii
+    std::unordered_map<char32_t, Character> extended_characters; // every other code
+    Character fallback;                                      // drawn for codes missing from the font
+    GlyphAtlas atlas;
+
+    const std::filesystem::path font_path;
+    FontFile * font_file;      // shared with every other CharacterSet of the same file
+    FT_Face face = nullptr;    // shared as well, only valid while size is active
+    FT_Size face_size = nullptr;
+    const unsigned int font_height;
+
+    std::filesystem::path cache_path; // empty when caching is disabled
+
+    KerningTable kerning;
+    signed char has_kerning = -1; // unknown until the face is opened or a cache is restored
+    signed long line_height = 0;  // distance between baselines, in 1/64 pixels
+
+    static constexpr unsigned int max_measurements = 4096;
+    std::unordered_map<size_t, TextMetrics> measurements; // keyed by string hash, measured at scale 1
+
+    std::array<GlyphQuad, 128> ascii_quads; // see get_ascii_quad
+    std::array<bool, 128> ascii_quads_ready{};
+    unsigned int ascii_quads_generation = 0;
+
+    std::vector<GlyphVertex> vertices;    // scratch space reused by render_string
+    std::vector<GlyphInstance> instances; // scratch space reused by render_string_instanced
 
     const unsigned int lower_ascii, upper_ascii;
+    bool lazy_loading = true; // rasterize glyphs on first use, off for fonts built from a fixed subset
+
+    static constexpr size_t max_kerning_subset = 256; // larger subsets only get the kerning of their corpus
+
+public:
+    /*
+    BITMAP glyphs are sharpest at font_height and blur or alias when scaled
+    SDF glyphs store signed distances to the outline, so one atlas renders crisply at any scale
+    */
+    enum RenderMode { BITMAP, SDF };
+
+protected:
+    const RenderMode render_mode;
 
     static std::unique_ptr<GLFWE::VertexArray> VAO;
+    static unsigned int VAO_capacity; // bytes currently allocated in the VAO buffer
     static std::unique_ptr<GLFWE::ShaderProgram> program;
 
-public:
-    CharacterSet(const std::filesystem::path & font_path, unsigned int font_height, unsigned int _lower_ascii = 0,  unsigned int _upper_ascii = 128):
-    lower_ascii(_lower_ascii), upper_ascii(_upper_ascii) {
-        // gl alignment
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);  
+    static std::unique_ptr<GLFWE::VertexArray> instanced_VAO;
+    static unsigned int instanced_VAO_capacity; // bytes currently allocated in the instance buffer
+    static std::unique_ptr<GLFWE::ShaderProgram> instanced_program;
 
+    static glm::vec2 projection_size; // last size passed to set_projection
+
+public:
+    /*
+    if cache_directory is given, the atlas and glyph metrics saved there by save_cache() are reused when
+    font file, height, range and mode still match, and FreeType is only initialized once a glyph is missing from the cache
+    */
+    CharacterSet(const std::filesystem::path & _font_path, unsigned int _font_height, unsigned int _lower_ascii = 0,  unsigned int _upper_ascii = 128, RenderMode _render_mode = BITMAP, const std::filesystem::path & cache_directory = {}):
+    characters(_upper_ascii - _lower_ascii),
+    atlas(atlas_width(_font_height)),
+    font_path(_font_path), font_file(FontManager::acquire(_font_path)), font_height(_font_height),
+    kerning(_lower_ascii, _upper_ascii),
+    lower_ascii(_lower_ascii), upper_ascii(_upper_ascii),
+    render_mode(_render_mode) {
         // prepare vertex array and program
         if (VAO == nullptr) {
             prepare_VAO_and_program();
         }
-        
-        // init ft
-        FT_Library ft;
-        if (FT_Init_FreeType(&ft)) {
-            logger.log(Logger::CRITICAL) << "ERROR: Failed to init FreeType library";
+
+        atlas.set_eviction_callback([this](char32_t code) {
+            find_character(code).state = UNLOADED;
+        });
+
+        if (!cache_directory.empty() && font_file) {
+            cache_path = cache_directory / cache_key().file_name();
+            if (load_cache()) {
+                logger << "Successfully loaded font from cache: " << font_path.c_str() << " (" << cache_path.c_str() << ")";
+                return;
+            }
         }
-        
-        // init face
-        FT_Face face;
-        if (FT_New_Face(ft, font_path.c_str(), 0, &face)) {
-            logger.log(Logger::CRITICAL) << "ERROR: Failed to load font into FreeType";
+
+        // the font's missing glyph (index 0) stands in for anything that is not in the font, it is never evicted
+        if (!get_face() || !rasterize(face, 0, render_mode) || !load_character(0, face->glyph, fallback)) {
+            logger.log(Logger::CRITICAL) << "FreeType failed to load the fallback glyph";
+            // draw nothing rather than whatever a failed load left behind
+            fallback = Character{};
+            fallback.prepare_quad();
+            fallback.state = RESIDENT;
+        } else {
+            atlas.pin(fallback.shelf);
         }
 
-        // set ft font size
-        FT_Set_Pixel_Sizes(face, 0, font_height); 
+        logger << "Successfully loaded " << (render_mode == SDF ? "SDF " : "") << "font: " << font_path.c_str() << " (" << lower_ascii << " - " << upper_ascii-1 << " indexed, glyphs are rasterized on first use)";
+    }
 
-        // load each character
-        for (unsigned char character = lower_ascii; character < upper_ascii; character++) {
-            if (FT_Load_Char(face, character, FT_LOAD_RENDER)) {
-                logger.log(Logger::CRITICAL) << "FreeType failed to load character glyph for: " << character;
-            }
+    /*
+    builds the font from a prebaked BMFont instead of FreeType, the pages are decoded once and their glyphs packed into the atlas
+    glyphs missing from the BMFont are drawn as the fallback, which is U+FFFD or '?' when the font has them
+    */
+    CharacterSet(const BMFont & bmfont, unsigned int _lower_ascii = 0, unsigned int _upper_ascii = 128, RenderMode _render_mode = BITMAP):
+    characters(_upper_ascii - _lower_ascii),
+    atlas(atlas_width(bmfont.size)),
+    font_path(bmfont.path), font_file(nullptr), font_height(bmfont.size),
+    kerning(_lower_ascii, _upper_ascii),
+    lower_ascii(_lower_ascii), upper_ascii(_upper_ascii),
+    render_mode(_render_mode) {
+        if (VAO == nullptr) {
+            prepare_VAO_and_program();
+        }
 
-            characters.emplace(character, Character());
-            characters[character].size = glm::ivec2(face->glyph->bitmap.width, face->glyph->bitmap.rows);
-            characters[character].bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
-            characters[character].advance = face->glyph->advance.x;
+        atlas.set_eviction_callback([this](char32_t code) {
+            find_character(code).state = UNLOADED;
+        });
 
-            characters[character].texture.buffer_image_2D(0, GL_RED, face->glyph->bitmap.width, face->glyph->bitmap.rows, GL_RED, GL_UNSIGNED_BYTE, face->glyph->bitmap.buffer, 1);
-            characters[character].texture.set_wrapping_behavior(WRAP_CLAMP_EDGE).set_filtering_behavior(FILTER_LINEAR);            
+        load_bmfont(bmfont);
+    }
+
+    /*
+    rasterizes only the glyphs of codes (on the preload worker pool) instead of relying on lazy loading over a range
+    with load_other_glyphs off, anything outside the subset is drawn as the fallback glyph and FreeType is never used after
+    construction, the subset is pinned in the atlas since it could not be rasterized again
+    kerning is then looked up up front as well, for every pair of a subset of up to max_kerning_subset codes
+    */
+    CharacterSet(const std::filesystem::path & _font_path, unsigned int _font_height, const std::vector<char32_t> & codes, RenderMode _render_mode = BITMAP, const std::filesystem::path & cache_directory = {}, bool load_other_glyphs = false):
+    CharacterSet(_font_path, _font_height, 0, 128, _render_mode, cache_directory) {
+        preload(codes);
+        lazy_loading = load_other_glyphs;
+        if (lazy_loading) return;
+
+        for (Character & character : characters) {
+            if (character.state == RESIDENT) atlas.pin(character.shelf);
+        }
+        for (auto & [code, character] : extended_characters) {
+            if (character.state == RESIDENT) atlas.pin(character.shelf);
         }
-        
-        // revert alignment
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);   
+        if (codes.size() <= max_kerning_subset) {
+            for (char32_t left : codes) {
+                for (char32_t right : codes) preload_kerning(left, right);
+            }
+        }
+        logger << "Font " << font_path.c_str() << " limited to a subset of " << codes.size() << " codes";
+    }
 
-        // cleanup
-        FT_Done_Face(face);
-        FT_Done_FreeType(ft);
+    // same as above, with the subset being every code that appears in the utf-8 encoded corpus, kerned as in the corpus
+    CharacterSet(const std::filesystem::path & _font_path, unsigned int _font_height, const std::string & corpus, RenderMode _render_mode = BITMAP, const std::filesystem::path & cache_directory = {}, bool load_other_glyphs = false):
+    CharacterSet(_font_path, _font_height, codes_in(corpus), _render_mode, cache_directory, load_other_glyphs) {
+        if (lazy_loading) return;
 
-        logger << "Successfully loaded font: " << font_path.c_str() << " (" << lower_ascii << " - " << upper_ascii-1 << ")";
+        char32_t previous = 0;
+        std::string::const_iterator c = corpus.begin();
+        while (c != corpus.end()) {
+            char32_t code = decode_utf8(c, corpus.end());
+            if (previous && code != '\n') preload_kerning(previous, code);
+            previous = code == '\n' ? 0 : code;
+        }
     }
 
+    CharacterSet(CharacterSet & other) = delete;
+
     ~CharacterSet() {
         destroy();
     }
 
+    /*
+    returns the glyph for code, rasterizing it into the atlas if needed
+    the atlas is uploaded lazily, call flush_atlas() before drawing with the result
+    */
+    const Character & get_character(char32_t code) {
+        Character & ch = find_character(code);
+        // a full atlas stays full for the rest of its current use, so a deferred glyph is not rasterized again until then
+        if (ch.state == DEFERRED && ch.deferred_use != atlas.get_use()) ch.state = UNLOADED;
+        if (ch.state == UNLOADED) load_character(code, ch);
+        if (ch.state != RESIDENT) return fallback;
+
+        atlas.touch(ch.shelf);
+        return ch;
+    }
+
+    // every distinct code of a utf-8 encoded string, sorted
+    static std::vector<char32_t> codes_in(const std::string & text) {
+        std::vector<char32_t> codes;
+        std::string::const_iterator c = text.begin();
+        while (c != text.end()) codes.push_back(decode_utf8(c, text.end()));
+
+        std::sort(codes.begin(), codes.end());
+        codes.erase(std::unique(codes.begin(), codes.end()), codes.end());
+        return codes;
+    }
+
+    // rasterizes every code in [first, last) ahead of time
+    void preload(char32_t first, char32_t last) {
+        std::vector<char32_t> codes;
+        for (char32_t code = first; code < last; code++) codes.push_back(code);
+        preload(codes);
+    }
+
+    /*
+    rasterizes codes ahead of time on a pool of worker threads
+    each worker opens its own FreeType library and face on the shared memory of the font file
+    the bitmaps are packed and uploaded to the atlas in one go, so this must be called on the gl thread
+    */
+    void preload(const std::vector<char32_t> & codes) {
+        std::vector<char32_t> pending(codes);
+        std::sort(pending.begin(), pending.end());
+        pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+
+        std::vector<RasterizedGlyph> glyphs;
+        for (char32_t code : pending) {
+            GlyphState state = find_character(code).state;
+            if (state != UNLOADED && state != DEFERRED) continue;
+            RasterizedGlyph & glyph = glyphs.emplace_back();
+            glyph.code = code;
+        }
+        if (glyphs.empty() || !get_face()) return;
+
+        // small batches are not worth a thread each
+        unsigned int thread_count = std::max(1u, std::min(std::thread::hardware_concurrency(), (unsigned int) (glyphs.size() + 31) / 32));
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < thread_count; t++) {
+            workers.emplace_back([this, &glyphs, t, thread_count]() {
+                FT_Library worker_ft;
+                FT_Face worker_face;
+                if (FT_Init_FreeType(&worker_ft)) return;
+                if (FT_New_Memory_Face(worker_ft, font_file->data(), font_file->size(), 0, &worker_face)) {
+                    FT_Done_FreeType(worker_ft);
+                    return;
+                }
+                FT_Set_Pixel_Sizes(worker_face, 0, font_height);
+
+                for (unsigned int i = t; i < glyphs.size(); i += thread_count) {
+                    rasterize(worker_face, glyphs[i], render_mode);
+                }
+
+                FT_Done_Face(worker_face);
+                FT_Done_FreeType(worker_ft);
+            });
+        }
+        for (std::thread & worker : workers) worker.join();
+
+        // tallest first, so shelves are opened at the height of the glyphs that fill them
+        std::sort(glyphs.begin(), glyphs.end(), [](const RasterizedGlyph & a, const RasterizedGlyph & b) {
+            return a.size.y > b.size.y;
+        });
+
+        atlas.begin_use();
+        for (RasterizedGlyph & glyph : glyphs) {
+            Character & ch = find_character(glyph.code);
+            if (!glyph.rasterized) {
+                ch.state = MISSING;
+                continue;
+            }
+            store_character(glyph.code, glyph.size, glyph.bearing, glyph.advance, glyph.bitmap.data(), glyph.size.x, ch);
+        }
+        flush_atlas();
+
+        logger << "Preloaded " << glyphs.size() << " glyphs on " << thread_count << " threads";
+    }
+
+    void flush_atlas() {
+        atlas.flush();
+    }
+
+    /*
+    writes the atlas and the metrics of every glyph rasterized so far to the cache directory given at construction
+    call it after preloading, so later runs start with those glyphs
+    */
+    bool save_cache() {
+        if (cache_path.empty()) {
+            logger.log(Logger::WARNING) << "Font " << font_path.c_str() << " was created without a cache directory";
+            return false;
+        }
+
+        CacheWriter out;
+        cache_key().write(out);
+        write_character(out, fallback);
+
+        uint32_t glyph_count = 0;
+        auto count_position = out.bytes.size();
+        out.write(glyph_count);
+        for (unsigned int i = 0; i < characters.size(); i++) {
+            if (characters[i].state == UNLOADED || characters[i].state == DEFERRED) continue;
+            out.write<uint32_t>(lower_ascii + i);
+            write_character(out, characters[i]);
+            glyph_count++;
+        }
+        for (auto & [code, character] : extended_characters) {
+            if (character.state == UNLOADED || character.state == DEFERRED) continue;
+            out.write<uint32_t>(code);
+            write_character(out, character);
+            glyph_count++;
+        }
+        std::memcpy(&out.bytes[count_position], &glyph_count, sizeof(glyph_count));
+
+        out.write<int8_t>(has_kerning);
+        out.write<int64_t>(line_height);
+        kerning.serialize(out);
+        atlas.serialize(out);
+
+        // write next to the target and rename, so a crash never leaves a half written cache behind
+        std::error_code error;
+        std::filesystem::create_directories(cache_path.parent_path(), error);
+        std::filesystem::path temporary_path = cache_path;
+        temporary_path += ".tmp";
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+        file.write((const char *) out.bytes.data(), out.bytes.size());
+        file.close();
+        if (!file) {
+            logger.log(Logger::WARNING) << "Failed to write font cache: " << temporary_path.c_str();
+            return false;
+        }
+        std::filesystem::rename(temporary_path, cache_path, error);
+        if (error) {
+            logger.log(Logger::WARNING) << "Failed to write font cache: " << cache_path.c_str();
+            return false;
+        }
+
+        logger << "Saved " << glyph_count << " glyphs to font cache: " << cache_path.c_str();
+        return true;
+    }
+
     void destroy() {
+        if (face_size) FT_Done_Size(face_size);
+        FontManager::release(font_file);
+        face_size = nullptr;
+        face = nullptr;
+        font_file = nullptr;
+
         if (Window::has_terminated()) return;
         characters.clear();
+        extended_characters.clear();
         logger << "Font destroyed";
     }
 
     static void set_projection(glm::vec2 projection) {
-        program->use();
+        projection_size = projection;
         glm::mat4 projection_matrix = glm::ortho(0.0f, projection.x, 0.0f, projection.y);
-        glUniformMatrix4fv(program->get_uniform_location("projection"), 1, GL_FALSE, glm::value_ptr(projection_matrix));
+        for (auto & shader_program : {program.get(), instanced_program.get()}) {
+            shader_program->use();
+            glUniformMatrix4fv(shader_program->get_uniform_location("projection"), 1, GL_FALSE, glm::value_ptr(projection_matrix));
+        }
+    }
+
+    static glm::vec2 get_projection() {
+        return projection_size;
     }
 
     void render_string(const std::string & text, glm::vec2 position, float scale, const glm::vec3 color) {
+        // lay out the whole string on the cpu first
+        vertices.clear();
+        append_string_vertices(text, position, scale, vertices);
+        if (vertices.empty()) return;
+
+        // one upload and one draw for the entire string
+        upload_vertices(vertices);
+        draw_vertex_array(*VAO, vertices.size(), glm::vec2(0.0f), color);
+    }
+
+    /*
+    draws text with every span in its own color, still in a single draw call
+    spans must be sorted and must not overlap, text outside of them is drawn in default_color
+    */
+    void render_styled_string(const std::string & text, const std::vector<TextSpan> & spans, glm::vec2 position, float scale, glm::vec4 default_color = glm::vec4(1.0f)) {
+        vertices.clear();
+        append_styled_vertices(text, spans, position, scale, vertices, default_color);
+        if (vertices.empty()) return;
+
+        upload_vertices(vertices);
+        draw_vertex_array(*VAO, vertices.size(), glm::vec2(0.0f), glm::vec3(1.0f));
+    }
+
+    /*
+    draws the first vertex_count vertices of a vertex array filled by append_string_vertices
+    and set up with assign_vertex_attributes, moved by offset
+    */
+    void draw_vertex_array(GLFWE::VertexArray & vertex_array, unsigned int vertex_count, glm::vec2 offset, const glm::vec3 color) {
+        flush_atlas();
         program->use();
-        VAO-> bind();
 
         // color
         glUniform3f(program->get_uniform_location("textColor"), color.x, color.y, color.z);
+        glUniform1i(program->get_uniform_location("distanceField"), render_mode == SDF);
+        glUniform2f(program->get_uniform_location("offset"), offset.x, offset.y);
+
+        // all glyphs share one texture
+        atlas.bind();
+
+        vertex_array.draw(GL_TRIANGLES, vertex_count, 0);
+    }
+
+    // same as draw_vertex_array for several ranges of one vertex array, the uniforms shared by all ranges are set once
+    void draw_vertex_ranges(GLFWE::VertexArray & vertex_array, const std::vector<VertexRange> & ranges, const glm::vec3 color) {
+        if (ranges.empty()) return;
+        flush_atlas();
+        program->use();
+
+        glUniform3f(program->get_uniform_location("textColor"), color.x, color.y, color.z);
+        glUniform1i(program->get_uniform_location("distanceField"), render_mode == SDF);
+        int offset_location = program->get_uniform_location("offset");
+
+        atlas.bind();
+
+        for (const VertexRange & range : ranges) {
+            glUniform2f(offset_location, range.offset.x, range.offset.y);
+            vertex_array.draw(GL_TRIANGLES, range.count, range.first);
+        }
+    }
+
+    // describes the GlyphVertex layout to a vertex array that text vertices will be buffered into
+    static void assign_vertex_attributes(GLFWE::VertexArray & vertex_array) {
+        vertex_array.assign_vertex_attribute(0, 4, GL_FLOAT, GL_FALSE, sizeof(GlyphVertex), offsetof(GlyphVertex, position));
+        vertex_array.assign_vertex_attribute(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(GlyphVertex), offsetof(GlyphVertex, color));
+    }
+
+    /*
+    quad of an ascii character, looked up once and reused until the atlas evicts glyphs
+    meant for labels that place a few glyphs every frame, bytes outside of ascii get the fallback glyph
+    */
+    const GlyphQuad & get_ascii_quad(char c) {
+        if (ascii_quads_generation != atlas.get_generation()) {
+            ascii_quads_ready.fill(false);
+            ascii_quads_generation = atlas.get_generation();
+        }
+
+        unsigned char index = (unsigned char) c < 128 ? c : 0;
+        if (!ascii_quads_ready[index]) {
+            const Character & ch = get_character(index);
+            ascii_quads[index] = {ch.quad, ch.texels, (float) (ch.advance >> 6)};
+            ascii_quads_ready[index] = true;
+        }
+        return ascii_quads[index];
+    }
+
+    // changes whenever glyphs were evicted from the atlas, retained vertices built before that must be rebuilt
+    unsigned int get_atlas_generation() {
+        return atlas.get_generation();
+    }
+
+    /*
+    makes every string laid out until release_atlas_use() one use of the atlas,
+    so rebuilding several retained strings in a row cannot evict the glyphs of the ones already rebuilt
+    */
+    void hold_atlas_use() {
+        atlas.hold_use();
+    }
+
+    void release_atlas_use() {
+        atlas.release_use();
+    }
+
+    /*
+    same result as render_string, but each glyph is sent as one 36 byte instance of a static unit quad
+    instead of six vertices, which is cheaper for large amounts of text
+    */
+    void render_string_instanced(const std::string & text, glm::vec2 position, float scale, const glm::vec3 color) {
+        instances.clear();
+        append_string_instances(text, position, scale, glm::vec4(color, 1.0f), instances);
+        if (instances.empty()) return;
+
+        flush_atlas();
+        instanced_program->use();
+        glUniform1i(instanced_program->get_uniform_location("distanceField"), render_mode == SDF);
+        atlas.bind();
+
+        upload_instances(instances);
+        instanced_VAO->draw_instanced(GL_TRIANGLE_STRIP, 4, instances.size(), 0);
+    }
+
+    // instanced version of render_styled_string
+    void render_styled_string_instanced(const std::string & text, const std::vector<TextSpan> & spans, glm::vec2 position, float scale, glm::vec4 default_color = glm::vec4(1.0f)) {
+        instances.clear();
+        append_styled_instances(text, spans, position, scale, instances, default_color);
+        if (instances.empty()) return;
+
+        flush_atlas();
+        instanced_program->use();
+        glUniform1i(instanced_program->get_uniform_location("distanceField"), render_mode == SDF);
+        atlas.bind();
+
+        upload_instances(instances);
+        instanced_VAO->draw_instanced(GL_TRIANGLE_STRIP, 4, instances.size(), 0);
+    }
+
+    /*
+    appends two triangles per character of text to out
+    positions are in screen space, texture coordinates in atlas texels
+    */
+    void append_string_vertices(const std::string & text, glm::vec2 position, float scale, std::vector<GlyphVertex> & out) {
+        append_styled_vertices(text, {}, position, scale, out);
+    }
+
+    // same as append_string_vertices, but every glyph takes the color of the span covering its first byte
+    void append_styled_vertices(const std::string & text, const std::vector<TextSpan> & spans, glm::vec2 position, float scale, std::vector<GlyphVertex> & out, glm::vec4 default_color = glm::vec4(1.0f)) {
+        // every byte is at most one glyph, write straight into the vector and trim afterwards
+        size_t start = out.size();
+        out.resize(start + text.size() * 6);
+        GlyphVertex * cursor = out.data() + start;
+
+        SpanCursor colors(spans, pack_color(default_color));
+        for_each_glyph(text, position, scale, [&cursor, &colors, scale](size_t byte, char32_t, const Character & ch, glm::vec2 pen, glm::vec4 rect) {
+            if (rect.z == 0 || rect.w == 0) return;
+            write_glyph_quad(cursor, pen, scale, ch.quad, ch.texels, colors.at(byte));
+            cursor += 6;
+        });
+        out.resize(cursor - out.data());
+    }
+
+    // appends one instance per character of text to out
+    void append_string_instances(const std::string & text, glm::vec2 position, float scale, glm::vec4 color, std::vector<GlyphInstance> & out) {
+        append_styled_instances(text, {}, position, scale, out, color);
+    }
+
+    void append_styled_instances(const std::string & text, const std::vector<TextSpan> & spans, glm::vec2 position, float scale, std::vector<GlyphInstance> & out, glm::vec4 default_color = glm::vec4(1.0f)) {
+        out.reserve(out.size() + text.size());
+
+        SpanCursor colors(spans, pack_color(default_color));
+        for_each_glyph(text, position, scale, [&out, &colors](size_t byte, char32_t, const Character & ch, glm::vec2, glm::vec4 rect) {
+            if (rect.z == 0 || rect.w == 0) return;
+            out.push_back({rect, ch.texels, colors.at(byte)});
+        });
+    }
+
+    /*
+    positions and quads of every glyph of text as render_string would draw it, including kerning and line breaks
+    rasterizes glyphs into the atlas if needed but does not touch gl
+    */
+    TextLayout layout_string(const std::string & text, glm::vec2 position, float scale) {
+        TextLayout result;
+        result.glyphs.reserve(text.size());
+        bool first = true;
+        result.lines = text.empty() ? 0 : 1;
+
+        result.end_pen = for_each_glyph(text, position, scale, [&](size_t, char32_t code, const Character & ch, glm::vec2 pen, glm::vec4 rect) {
+            if (code == '\n') {
+                result.lines++;
+                return;
+            }
+            result.glyphs.push_back({code, pen, rect, (ch.advance >> 6) * scale});
+            if (rect.z == 0 || rect.w == 0) return;
+
+            glm::vec4 glyph_bounds(rect.x, rect.y, rect.x + rect.z, rect.y + rect.w);
+            result.bounds = first ? glyph_bounds : glm::vec4(
+                std::min(result.bounds.x, glyph_bounds.x), std::min(result.bounds.y, glyph_bounds.y),
+                std::max(result.bounds.z, glyph_bounds.z), std::max(result.bounds.w, glyph_bounds.w));
+            first = false;
+        });
+        return result;
+    }
+
+    /*
+    size of text when drawn at scale
+    results are cached by string hash, so measuring the same string again is a single lookup
+    */
+    TextMetrics measure_string(const std::string & text, float scale = 1.0f) {
+        size_t key = std::hash<std::string>{}(text);
+        auto it = measurements.find(key);
+        if (it == measurements.end()) {
+            if (measurements.size() >= max_measurements) measurements.clear();
+            it = measurements.emplace(key, measure_unscaled(text)).first;
+        }
+
+        TextMetrics scaled = it->second;
+        scaled.width *= scale;
+        scaled.height *= scale;
+        scaled.bounds = scaled.bounds * scale;
+        return scaled;
+    }
+
+    /*
+    end of the line that starts at byte begin of text when wrapped to max_width (0 disables wrapping)
+    lines end after a '\n' or after the last space that keeps them within max_width, spaces may hang past it
+    a word wider than max_width is broken between characters
+    */
+    size_t wrap_line(const std::string & text, size_t begin, float max_width, float scale) {
+        atlas.begin_use();
+
+        float width = 0;
+        char32_t previous = 0;
+        size_t last_break = std::string::npos; // just past the last space
+
+        std::string::const_iterator c = text.begin() + begin;
+        while (c != text.end()) {
+            size_t start = c - text.begin();
+            char32_t code = decode_utf8(c, text.end());
+            if (code == '\n') return c - text.begin();
+
+            const Character & ch = get_character(code);
+            float advance = (ch.advance >> 6) * scale;
+            if (previous) advance += get_kerning(previous, code) / 64.0f * scale;
+            previous = code;
+
+            if (code == ' ') {
+                last_break = c - text.begin();
+            } else if (max_width > 0 && width + advance > max_width && start != begin) {
+                return last_break != std::string::npos ? last_break : start;
+            }
+            width += advance;
+        }
+        return text.size();
+    }
+
+    // distance between the baselines of two lines at scale 1, in pixels
+    float get_line_height() {
+        if (line_height == 0) get_face();
+        return line_height / 64.0f;
+    }
+
+protected:
+    TextMetrics measure_unscaled(const std::string & text) {
+        TextMetrics metrics;
+        TextLayout layout = layout_string(text, glm::vec2(0.0f), 1.0f);
+
+        // line widths come from the pen rather than the glyph quads, so trailing spaces count
+        for (GlyphPlacement & glyph : layout.glyphs) {
+            metrics.width = std::max(metrics.width, glyph.pen.x + glyph.advance);
+        }
+        metrics.lines = layout.lines;
+        metrics.height = layout.lines * get_line_height();
+        metrics.bounds = layout.bounds;
+        return metrics;
+    }
+
+    // kerning between two codes in 1/64 pixels, looked up once per pair
+    int get_kerning(char32_t left, char32_t right) {
+        if (has_kerning == 0) return 0;
+
+        int value;
+        if (kerning.find(left, right, value)) return value;
+        if (!lazy_loading) return 0; // the face is not touched after a subset font is built, see preload_kerning
+        return load_kerning(left, right);
+    }
+
+    // looks a pair up while a subset font is built, pairs restored from a cache do not open the face
+    void preload_kerning(char32_t left, char32_t right) {
+        int value;
+        if (has_kerning != 0 && !kerning.find(left, right, value)) load_kerning(left, right);
+    }
+
+    int load_kerning(char32_t left, char32_t right) {
+        if (!get_face() || !has_kerning) return 0;
+
+        FT_Vector delta;
+        if (FT_Get_Kerning(face, FT_Get_Char_Index(face, left), FT_Get_Char_Index(face, right), FT_KERNING_DEFAULT, &delta)) delta.x = 0;
+        kerning.store(left, right, delta.x);
+        return delta.x;
+    }
+
+    // walks sorted spans alongside increasing byte offsets
+    struct SpanCursor {
+        const std::vector<TextSpan> & spans;
+        unsigned int default_color;
+        size_t next = 0;
+
+        SpanCursor(const std::vector<TextSpan> & _spans, unsigned int _default_color):
+        spans(_spans), default_color(_default_color) {}
+
+        unsigned int at(size_t byte) {
+            while (next < spans.size() && spans[next].end <= byte) next++;
+            if (next < spans.size() && spans[next].begin <= byte) return pack_color(spans[next].color);
+            return default_color;
+        }
+    };
+
+    /*
+    calls func(byte, code, character, pen, rect) with every character of the utf-8 encoded text, byte being its offset in text
+    rect is the glyph's screen space quad (left, bottom, width, height), a line break is passed with an empty rect
+    counts as one use of the atlas, so no glyph of text can be evicted by another glyph of text
+    returns the pen position after the last character
+    */
+    template<typename F>
+    glm::vec2 for_each_glyph(const std::string & text, glm::vec2 position, float scale, F && func) {
+        atlas.begin_use();
+
+        float line_start = position.x;
+        char32_t previous = 0;
 
         // iterate through all characters
-        std::string::const_iterator c;
-        for (c = text.begin(); c != text.end(); c++) 
+        std::string::const_iterator c = text.begin();
+        while (c != text.end()) 
         {
-            Character & ch = characters[*c];
+            size_t byte = c - text.begin();
+            char32_t code = decode_utf8(c, text.end());
+            if (code == '\n') {
+                func(byte, code, fallback, position, glm::vec4(position.x, position.y, 0.0f, 0.0f));
+                position.x = line_start;
+                position.y -= get_line_height() * scale;
+                previous = 0;
+                continue;
+            }
+
+            const Character & ch = get_character(code);
+            if (previous) position.x += get_kerning(previous, code) / 64.0f * scale;
+            previous = code;
 
             float xpos = position.x + ch.bearing.x * scale;
             float ypos = position.y - (ch.size.y - ch.bearing.y) * scale;
@@ -124,25 +789,284 @@ public:
             float w = ch.size.x * scale;
             float h = ch.size.y * scale;
 
-            // update VBO for each character
-            float vertices[6][4] = {
-                { xpos,     ypos + h,   0.0f, 0.0f },            
-                { xpos,     ypos,       0.0f, 1.0f },
-                { xpos + w, ypos,       1.0f, 1.0f },
+            func(byte, code, ch, position, glm::vec4(xpos, ypos, w, h));
+
+            // now advance cursors for next glyph (note that advance is number of 1/64 pixels)
+            position.x += (ch.advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64 (divide amount of 1/64th pixels by 64 to get amount of pixels))
+        }
+        return position;
+    }
+
+    Character & find_character(char32_t code) {
+        unsigned int index = code - lower_ascii; // codes below lower_ascii wrap around and fail the bounds check
+        return index < characters.size() ? characters[index] : extended_characters[code];
+    }
+
+    /*
+    the face is only parsed once a glyph has to be rasterized
+    other CharacterSets may have switched it to their size since, so this activates ours before every use
+    */
+    FT_Face get_face() {
+        if (face) {
+            FT_Activate_Size(face_size);
+            return face;
+        }
+
+        face = FontManager::get_face(font_file);
+        if (!face) return nullptr;
+
+        // every CharacterSet of a face gets its own size object
+        if (FT_New_Size(face, &face_size)) {
+            logger.log(Logger::CRITICAL) << "ERROR: Failed to create a FreeType size for " << font_path.c_str();
+            face = nullptr;
+            return nullptr;
+        }
+        FT_Activate_Size(face_size);
+
+        // set ft font size
+        FT_Set_Pixel_Sizes(face, 0, font_height); 
+
+        has_kerning = FT_HAS_KERNING(face) ? 1 : 0;
+        line_height = face->size->metrics.height;
+        return face;
+    }
+
+    GlyphCacheKey cache_key() {
+        return GlyphCacheKey{std::filesystem::absolute(font_path).string(), font_file ? font_file->get_hash() : 0, font_height, lower_ascii, upper_ascii, (uint32_t) render_mode};
+    }
+
+    static void write_character(CacheWriter & out, const Character & character) {
+        out.write<int32_t>(character.size.x);
+        out.write<int32_t>(character.size.y);
+        out.write<int32_t>(character.bearing.x);
+        out.write<int32_t>(character.bearing.y);
+        out.write<int64_t>(character.advance);
+        for (int i = 0; i < 4; i++) out.write<int32_t>(character.uv[i]);
+        out.write<uint32_t>(character.shelf);
+        out.write<uint8_t>(character.state);
+    }
+
+    static Character read_character(CacheReader & in) {
+        Character character;
+        character.size.x = in.read<int32_t>();
+        character.size.y = in.read<int32_t>();
+        character.bearing.x = in.read<int32_t>();
+        character.bearing.y = in.read<int32_t>();
+        character.advance = in.read<int64_t>();
+        for (int i = 0; i < 4; i++) character.uv[i] = in.read<int32_t>();
+        character.shelf = in.read<uint32_t>();
+        character.state = (GlyphState) in.read<uint8_t>();
+        character.prepare_quad();
+        return character;
+    }
+
+    // restores a cache written by save_cache(), nothing is changed unless the whole file is valid
+    bool load_cache() {
+        MappedFile file(cache_path);
+        if (!file.is_open()) return false;
 
-                { xpos,     ypos + h,   0.0f, 0.0f },
-                { xpos + w, ypos,       1.0f, 1.0f },
-                { xpos + w, ypos + h,   1.0f, 0.0f }           
+        CacheReader in(file.data(), file.size());
+        if (!cache_key().matches(in)) {
+            logger << "Font cache " << cache_path.c_str() << " is stale and will be ignored";
+            return false;
+        }
+
+        Character cached_fallback = read_character(in);
+        std::vector<std::pair<char32_t, Character>> cached;
+        uint32_t glyph_count = in.read<uint32_t>();
+        for (uint32_t i = 0; i < glyph_count && in.good(); i++) {
+            char32_t code = in.read<uint32_t>();
+            cached.emplace_back(code, read_character(in));
+        }
+        signed char cached_has_kerning = in.read<int8_t>();
+        signed long cached_line_height = in.read<int64_t>();
+        KerningTable cached_kerning(lower_ascii, upper_ascii);
+        // every resident glyph has to sit on a restored shelf, its texels are kept inside the atlas
+        auto accept_glyphs = [&](glm::ivec2 dimensions, unsigned int shelf_count) {
+            auto accept = [&](Character & character) {
+                if (character.state > MISSING) return false;
+                if (character.state != RESIDENT) return true;
+                if (character.shelf >= shelf_count) return false;
+                for (int i = 0; i < 4; i++) character.uv[i] = std::clamp(character.uv[i], 0, dimensions[i % 2]);
+                character.prepare_quad();
+                return true;
             };
-            
-            ch.texture.bind();
+            if (!accept(cached_fallback)) return false;
+            for (auto & [code, character] : cached) if (!accept(character)) return false;
+            return true;
+        };
+        if (!in.good() || cached_fallback.state != RESIDENT || !cached_kerning.deserialize(in) || !atlas.deserialize(in, accept_glyphs)) {
+            logger.log(Logger::WARNING) << "Font cache " << cache_path.c_str() << " is corrupt and will be ignored";
+            return false;
+        }
 
-            VAO->buffer_vertex_sub_data(0, vertices);
-            VAO->draw(GL_TRIANGLES, 6, 0);
+        fallback = cached_fallback;
+        for (auto & [code, character] : cached) find_character(code) = character;
+        has_kerning = cached_has_kerning;
+        line_height = cached_line_height;
+        kerning = std::move(cached_kerning);
+        return true;
+    }
 
-            // now advance cursors for next glyph (note that advance is number of 1/64 pixels)
-            position.x += (ch.advance >> 6) * scale; // bitshift by 6 to get value in pixels (2^6 = 64 (divide amount of 1/64th pixels by 64 to get amount of pixels))
+    void load_bmfont(const BMFont & bmfont) {
+        has_kerning = 0;
+        line_height = (signed long) bmfont.line_height << 6;
+        fallback = Character{};
+        fallback.prepare_quad();
+        fallback.state = RESIDENT; // empty until the font provides one
+        if (!bmfont.is_open()) return;
+
+        std::vector<unsigned char> page, bitmap;
+        int page_width = 0, page_height = 0, channels = 0;
+        unsigned int loaded_page = UINT_MAX;
+        unsigned int glyph_count = 0;
+
+        // grouped by page so every page is decoded once, tallest first for tighter shelves
+        std::vector<const BMFont::Glyph *> glyphs;
+        for (const BMFont::Glyph & glyph : bmfont.glyphs) glyphs.push_back(&glyph);
+        std::sort(glyphs.begin(), glyphs.end(), [](const BMFont::Glyph * a, const BMFont::Glyph * b) {
+            return a->page != b->page ? a->page < b->page : a->height > b->height;
+        });
+
+        atlas.begin_use();
+        for (const BMFont::Glyph * glyph : glyphs) {
+            if (glyph->page >= bmfont.pages.size()) continue;
+            if (glyph->page != loaded_page) {
+                loaded_page = glyph->page;
+                if (!bmfont.load_page(loaded_page, page, page_width, page_height, channels)) page_width = page_height = 0;
+            }
+            if (glyph->x < 0 || glyph->y < 0 || glyph->x + glyph->width > page_width || glyph->y + glyph->height > page_height) continue;
+
+            // copy the glyph's coverage out of the interleaved page
+            int channel = bmfont.coverage_channel(*glyph, channels);
+            bitmap.resize(glyph->width * glyph->height);
+            for (int row = 0; row < glyph->height; row++) {
+                for (int column = 0; column < glyph->width; column++) {
+                    bitmap[row * glyph->width + column] = page[((size_t) (glyph->y + row) * page_width + glyph->x + column) * channels + channel];
+                }
+            }
+
+            // BMFont offsets are measured down from the top of the line, bearings up from the baseline
+            Character & character = find_character(glyph->id);
+            glm::ivec2 size(glyph->width, glyph->height), bearing(glyph->x_offset, bmfont.base - glyph->y_offset);
+            if (!store_character(glyph->id, size, bearing, (signed long) glyph->x_advance << 6, bitmap.data(), glyph->width, character)) continue;
+
+            // nothing can be rasterized again once evicted
+            atlas.pin(character.shelf);
+            glyph_count++;
+        }
+
+        for (const BMFont::KerningPair & pair : bmfont.kerning_pairs) {
+            kerning.store(pair.first, pair.second, pair.amount * 64);
+            has_kerning = 1;
+        }
+
+        for (char32_t code : {(char32_t) 0xFFFD, (char32_t) '?'}) {
+            Character & character = find_character(code);
+            if (character.state != RESIDENT) continue;
+            fallback = character;
+            break;
+        }
+        flush_atlas();
+
+        logger << "Successfully loaded BMFont: " << font_path.c_str() << " (" << glyph_count << " glyphs from " << bmfont.pages.size() << " pages)";
+    }
+
+    void load_character(char32_t code, Character & character) {
+        if (!lazy_loading || !get_face()) {
+            character.state = MISSING;
+            return;
+        }
+
+        FT_UInt glyph_index = FT_Get_Char_Index(face, code);
+        if (glyph_index == 0) {
+            character.state = MISSING;
+            return;
+        }
+        if (!rasterize(face, glyph_index, render_mode)) {
+            logger.log(Logger::CRITICAL) << "FreeType failed to load character glyph for: " << (unsigned int) code;
+            character.state = MISSING;
+            return;
+        }
+        load_character(code, face->glyph, character);
+    }
+
+    // loads a glyph into face->glyph and renders it according to mode
+    static bool rasterize(FT_Face face, FT_UInt glyph_index, RenderMode mode) {
+        if (mode == BITMAP) return !FT_Load_Glyph(face, glyph_index, FT_LOAD_RENDER);
+
+        if (FT_Load_Glyph(face, glyph_index, FT_LOAD_DEFAULT)) return false;
+        if (face->glyph->format == FT_GLYPH_FORMAT_OUTLINE && face->glyph->outline.n_points == 0) return true; // nothing to render, e.g. a space
+        return !FT_Render_Glyph(face->glyph, FT_RENDER_MODE_SDF);
+    }
+
+    // a glyph rendered off the gl thread, waiting to be packed
+    struct RasterizedGlyph {
+        char32_t code = 0;
+        bool rasterized = false;
+        glm::ivec2 size = glm::ivec2(0), bearing = glm::ivec2(0); // zero for glyphs that failed, which are still sorted
+        signed long advance = 0;
+        std::vector<unsigned char> bitmap; // rows of size.x bytes
+    };
+
+    static void rasterize(FT_Face face, RasterizedGlyph & glyph, RenderMode mode) {
+        FT_UInt glyph_index = FT_Get_Char_Index(face, glyph.code);
+        if (glyph_index == 0 || !rasterize(face, glyph_index, mode)) return;
+
+        FT_Bitmap & bitmap = face->glyph->bitmap;
+        glyph.size = glm::ivec2(bitmap.width, bitmap.rows);
+        glyph.bearing = glm::ivec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
+        glyph.advance = face->glyph->advance.x;
+        glyph.bitmap.resize(glyph.size.x * glyph.size.y);
+        for (int row = 0; row < glyph.size.y; row++) {
+            std::copy_n(bitmap.buffer + row * bitmap.pitch, glyph.size.x, glyph.bitmap.begin() + row * glyph.size.x);
+        }
+        glyph.rasterized = true;
+    }
+
+    bool load_character(char32_t code, FT_GlyphSlot glyph, Character & character) {
+        return store_character(code, glm::ivec2(glyph->bitmap.width, glyph->bitmap.rows), glm::ivec2(glyph->bitmap_left, glyph->bitmap_top), glyph->advance.x, glyph->bitmap.buffer, glyph->bitmap.pitch, character);
+    }
+
+    // copies the glyph bitmap into the atlas, defers the character if the atlas has no room
+    bool store_character(char32_t code, glm::ivec2 size, glm::ivec2 bearing, signed long advance, const unsigned char * bitmap, int pitch, Character & character) {
+        character.size = size;
+        character.bearing = bearing;
+        character.advance = advance;
+        if (!atlas.insert(code, size, bitmap, pitch, character.uv, character.shelf)) {
+            character.state = DEFERRED;
+            character.deferred_use = atlas.get_use();
+            return false;
+        }
+        character.prepare_quad();
+        character.state = RESIDENT;
+        return true;
+    }
+
+    // wide enough for roughly 16 glyphs per shelf
+    static int atlas_width(unsigned int font_height) {
+        int width = 256;
+        while (width < (int) font_height * 16 && width < 4096) width *= 2;
+        return width;
+    }
+
+    // streams vertices into the shared VAO, only reallocating its buffer when it is too small
+    static void upload_vertices(std::vector<GlyphVertex> & data) {
+        unsigned int data_size = sizeof(GlyphVertex) * data.size();
+        if (data_size > VAO_capacity) {
+            while (VAO_capacity < data_size) VAO_capacity *= 2;
+            VAO->buffer_vertex_data(VAO_capacity, NULL, DYNAMIC_DRAW);
+        }
+        VAO->buffer_vertex_sub_data(0, data);
+    }
+
+    static void upload_instances(std::vector<GlyphInstance> & data) {
+        unsigned int data_size = sizeof(GlyphInstance) * data.size();
+        if (data_size > instanced_VAO_capacity) {
+            while (instanced_VAO_capacity < data_size) instanced_VAO_capacity *= 2;
+            instanced_VAO->buffer_instance_data(instanced_VAO_capacity, NULL, DYNAMIC_DRAW);
         }
+        instanced_VAO->buffer_instance_sub_data(0, data);
     }
 
 private:
@@ -150,39 +1074,86 @@ private:
         VAO = std::make_unique<GLFWE::VertexArray>();
         program = std::make_unique<GLFWE::ShaderProgram>();
 
-        VAO->buffer_vertex_data(sizeof(float)*6*4, NULL, DYNAMIC_DRAW);
-        VAO->assign_vertex_attribute(0, 4, GL_FLOAT, GL_FALSE, 4*sizeof(float));
+        VAO->buffer_vertex_data(VAO_capacity, NULL, DYNAMIC_DRAW);
+        assign_vertex_attributes(*VAO);
+
+        // unit quad as a triangle strip, stretched over each glyph instance
+        float unit_quad[4][2] = {{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+        instanced_VAO = std::make_unique<GLFWE::VertexArray>();
+        instanced_program = std::make_unique<GLFWE::ShaderProgram>();
+
+        instanced_VAO->buffer_vertex_data(sizeof(unit_quad), unit_quad, STATIC_DRAW);
+        instanced_VAO->assign_vertex_attribute(0, 2, GL_FLOAT, GL_FALSE, 2*sizeof(float));
+        instanced_VAO->buffer_instance_data(instanced_VAO_capacity, NULL, DYNAMIC_DRAW);
+        instanced_VAO->assign_instance_attribute(1, 4, GL_FLOAT, GL_FALSE, sizeof(GlyphInstance), offsetof(GlyphInstance, rect));
+        instanced_VAO->assign_instance_attribute(2, 4, GL_FLOAT, GL_FALSE, sizeof(GlyphInstance), offsetof(GlyphInstance, uv));
+        instanced_VAO->assign_instance_attribute(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(GlyphInstance), offsetof(GlyphInstance, color));
 
         auto vertex_shader = GLFWE::Shader(VERTEX_SHADER);
         vertex_shader.load_raw(
             R"(#version 330 core
             layout (location = 0) in vec4 vertex;
+            layout (location = 1) in vec4 vertexColor;
+            out vec2 TexCoords;
+            out vec4 TextColor;
+
+            uniform mat4 projection;
+            uniform sampler2D text;
+            uniform vec3 textColor;
+            uniform vec2 offset;
+
+            void main()
+            {
+                gl_Position = projection * vec4(vertex.xy + offset, 0.0, 1.0);
+                TexCoords = vertex.zw / vec2(textureSize(text, 0));
+                TextColor = vec4(textColor, 1.0) * vertexColor;
+        })");
+        auto instanced_vertex_shader = GLFWE::Shader(VERTEX_SHADER);
+        instanced_vertex_shader.load_raw(
+            R"(#version 330 core
+            layout (location = 0) in vec2 corner;
+            layout (location = 1) in vec4 rect;
+            layout (location = 2) in vec4 uv;
+            layout (location = 3) in vec4 glyphColor;
             out vec2 TexCoords;
+            out vec4 TextColor;
 
             uniform mat4 projection;
+            uniform sampler2D text;
 
             void main()
             {
-                gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
-                TexCoords = vertex.zw;
+                gl_Position = projection * vec4(rect.xy + corner * rect.zw, 0.0, 1.0);
+                TexCoords = vec2(mix(uv.x, uv.z, corner.x), mix(uv.w, uv.y, corner.y)) / vec2(textureSize(text, 0));
+                TextColor = glyphColor;
         })");
         auto fragment_shader = GLFWE::Shader(FRAGMENT_SHADER);
         fragment_shader.load_raw(
             R"(#version 330 core
             in vec2 TexCoords;
+            in vec4 TextColor;
             out vec4 color;
 
             uniform sampler2D text;
-            uniform vec3 textColor;
+            uniform bool distanceField;
 
             void main()
             {    
-                vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
-                color = vec4(textColor, 1.0) * sampled;
+                float value = texture(text, TexCoords).r;
+
+                // signed distance fields put the outline at 0.5, antialias over one screen pixel around it
+                if (distanceField) {
+                    float width = fwidth(value);
+                    value = smoothstep(0.5 - width, 0.5 + width, value);
+                }
+
+                vec4 sampled = vec4(1.0, 1.0, 1.0, value);
+                color = TextColor * sampled;
             })"
         );
 
-        program->attach_shader(vertex_shader).attach_shader(fragment_shader).link().use();
+        program->attach_shader(vertex_shader).attach_shader(fragment_shader).link();
+        instanced_program->attach_shader(instanced_vertex_shader).attach_shader(fragment_shader).link();
 
         if (!Window::has_only_one_instance()) logger.log(Logger::WARNING) << "Multiple window instances detected. Please manually decalre the projection for GLFWE/Shape/CharacterSet";
         else {
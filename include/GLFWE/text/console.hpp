@@ -0,0 +1,183 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <GLFWE/vertex_array.hpp>
+
+#include <GLFWE/text/character_set.hpp>
+
+#include <logger/logger.hpp>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include <cmath>
+
+namespace GLFWE::Text {
+/*
+scrolling log view, new lines appear at the bottom of a rectangular viewport
+laid out lines are written once into a fixed size ring of vertices, appending never touches older lines
+the oldest lines are dropped when the ring wraps over them or history_lines is exceeded
+only the lines inside the viewport are drawn, so the cost of a frame does not depend on the length of the log
+the font must outlive the console
+*/
+class Console {
+protected:
+    static constexpr Logger logger = Logger("Console");
+
+    struct Line {
+        std::string text;           // kept to rebuild the vertices after atlas evictions
+        unsigned int first_vertex;
+        unsigned int count;         // vertices drawn
+        unsigned int slot;          // vertices reserved in the ring
+        unsigned int lap;           // how often the ring had wrapped when the line was written
+        unsigned int atlas_generation;
+    };
+
+    CharacterSet & font;
+    glm::vec4 viewport; // left, bottom, width, height
+    float scale;
+    glm::vec3 color;
+
+    std::deque<Line> lines;
+    unsigned int history_lines;
+    unsigned long long total_lines = 0;
+    unsigned int scroll_offset = 0; // lines between the bottom of the viewport and the newest line
+
+    GLFWE::VertexArray VAO;
+    unsigned int capacity;  // in vertices
+    unsigned int head = 0;  // next vertex to write
+    unsigned int lap = 0;
+
+    std::vector<GlyphVertex> vertices; // scratch space reused for every line
+    std::vector<VertexRange> ranges;
+
+public:
+    Console(CharacterSet & _font, glm::vec4 _viewport, float _scale = 1.0f, glm::vec3 _color = {1, 1, 1}, unsigned int _history_lines = 100000, unsigned int vertex_capacity = 1 << 20):
+    font(_font), viewport(_viewport), scale(_scale), color(_color), history_lines(std::max(_history_lines, 1u)), capacity(vertex_capacity) {
+        VAO.buffer_vertex_data(sizeof(GlyphVertex) * capacity, nullptr, DYNAMIC_DRAW);
+        CharacterSet::assign_vertex_attributes(VAO);
+    }
+
+    Console(Console & other) = delete;
+    Console(Console && other) = default;
+
+    // adds text below the last line, '\n' starts a new line and lines wider than the viewport are wrapped
+    void append(const std::string & text) {
+        size_t begin = 0;
+        do {
+            size_t end = font.wrap_line(text, begin, viewport.z, scale);
+            size_t length = end - begin;
+            if (length && text[end - 1] == '\n') length--;
+            push_line(text.substr(begin, length));
+            begin = end;
+        } while (begin < text.size());
+    }
+
+    void clear() {
+        lines.clear();
+        head = 0;
+        scroll_offset = 0;
+    }
+
+    // positive amounts scroll towards older lines, stays at the newest line while scrolled to the bottom
+    void scroll(int amount) {
+        long target = (long) scroll_offset + amount;
+        scroll_offset = std::clamp(target, 0l, (long) std::max<size_t>(lines.size(), 1) - 1);
+    }
+    void scroll_to_bottom() {
+        scroll_offset = 0;
+    }
+
+    void set_viewport(glm::vec4 new_viewport) {
+        viewport = new_viewport;
+    }
+    void set_color(glm::vec3 new_color) {
+        color = new_color;
+    }
+
+    glm::vec4 get_viewport() { return viewport; }
+    glm::vec3 get_color() { return color; }
+    unsigned int get_scroll_offset() { return scroll_offset; }
+
+    // lines still held by the console
+    unsigned int get_line_count() {
+        return lines.size();
+    }
+    // lines appended since the console was created, including dropped ones
+    unsigned long long get_total_lines() {
+        return total_lines;
+    }
+
+    void draw() {
+        float line_height = font.get_line_height() * scale;
+        if (lines.empty() || line_height <= 0) return;
+
+        // the newest visible line sits on the bottom edge, a quarter line leaves room for descenders
+        unsigned int visible = std::ceil(viewport.w / line_height);
+        size_t newest = lines.size() - 1 - std::min<size_t>(scroll_offset, lines.size() - 1);
+
+        // the lines rebuilt here share one use of the atlas, but a rebuild can still evict the glyphs of a line that was up to date
+        // when that happens the pass is run once more, which rebuilds every line older than the eviction
+        font.hold_atlas_use();
+        for (int pass = 0; pass < 2; pass++) {
+            unsigned int generation = font.get_atlas_generation();
+
+            ranges.clear();
+            for (unsigned int row = 0; row < visible && row <= newest; row++) {
+                Line & line = lines[newest - row];
+                if (line.atlas_generation != font.get_atlas_generation()) rebuild(line);
+                if (line.count == 0) continue;
+
+                glm::vec2 offset(viewport.x, viewport.y + line_height * (row + 0.25f));
+                ranges.push_back({line.first_vertex, line.count, offset});
+            }
+            if (generation == font.get_atlas_generation()) break;
+        }
+        font.release_atlas_use();
+
+        font.draw_vertex_ranges(VAO, ranges, color);
+    }
+
+protected:
+    void push_line(std::string text) {
+        vertices.clear();
+        font.append_string_vertices(text, glm::vec2(0.0f), scale, vertices);
+
+        unsigned int count = vertices.size();
+        if (count > capacity) {
+            logger.log(Logger::WARNING) << "Line of " << count << " vertices does not fit in a ring of " << capacity << ", truncating";
+            count = capacity - capacity % 6;
+        }
+
+        // not enough room before the end of the ring, start over at the front
+        if (head + count > capacity) {
+            head = 0;
+            lap++;
+            while (!lines.empty() && lines.front().lap + 1 < lap) lines.pop_front();
+        }
+
+        // drop the lines of the previous lap that the new one overwrites
+        while (!lines.empty() && lines.front().lap < lap && lines.front().first_vertex < head + count) lines.pop_front();
+        while (lines.size() >= history_lines) lines.pop_front();
+
+        if (count) VAO.buffer_vertex_sub_data(sizeof(GlyphVertex) * head, sizeof(GlyphVertex) * count, vertices.data());
+        lines.push_back({std::move(text), head, count, count, lap, font.get_atlas_generation()});
+        head += count;
+        total_lines++;
+
+        // keep showing the same lines while scrolled up
+        if (scroll_offset) scroll(1);
+    }
+
+    // evicted glyphs moved in the atlas, lay the line out again into its own slot
+    void rebuild(Line & line) {
+        vertices.clear();
+        font.append_string_vertices(line.text, glm::vec2(0.0f), scale, vertices);
+        line.count = std::min<unsigned int>(vertices.size(), line.slot);
+        line.atlas_generation = font.get_atlas_generation();
+        if (line.count) VAO.buffer_vertex_sub_data(sizeof(GlyphVertex) * line.first_vertex, sizeof(GlyphVertex) * line.count, vertices.data());
+    }
+};
+}
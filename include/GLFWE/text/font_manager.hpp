@@ -0,0 +1,131 @@
+#pragma once
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_SIZES_H
+
+#include <GLFWE/mapped_file.hpp>
+
+#include <logger/logger.hpp>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace GLFWE::Text {
+/*
+a font file mapped into memory once, and the FreeType face parsed from it
+the face is shared by every CharacterSet using the file, each of them selects its own FT_Size before using it
+*/
+class FontFile {
+protected:
+    static constexpr Logger logger = Logger("Font File");
+
+    MappedFile file;
+    FT_Face face = nullptr;
+    unsigned long long hash = 0;
+    bool hashed = false;
+
+    friend class FontManager;
+    std::string key;
+    unsigned int users = 0;
+
+public:
+    FontFile(const std::filesystem::path & path):
+    file(path) {}
+
+    FontFile(FontFile & other) = delete;
+
+    ~FontFile() {
+        if (face) FT_Done_Face(face);
+    }
+
+    // the face is only parsed once a glyph has to be rasterized, nullptr if the file is not a font FreeType can read
+    FT_Face get_face(FT_Library library) {
+        if (face) return face;
+        if (FT_New_Memory_Face(library, file.data(), file.size(), 0, &face)) {
+            logger.log(Logger::CRITICAL) << "ERROR: Failed to load font into FreeType: " << key;
+            face = nullptr;
+        }
+        return face;
+    }
+
+    // the mapped contents, workers open their own faces on this memory
+    const unsigned char * data() {
+        return file.data();
+    }
+    size_t size() {
+        return file.size();
+    }
+
+    // hash of the contents, computed once per process
+    unsigned long long get_hash() {
+        if (!hashed) hash = file.hash();
+        hashed = true;
+        return hash;
+    }
+};
+
+/*
+owns the one FT_Library of the process and the font files opened through it
+every file is mapped and parsed once, no matter how many CharacterSets (e.g. one per size) use it
+like the rest of the gl side, only use it from the main thread
+*/
+class FontManager {
+protected:
+    static constexpr Logger logger = Logger("Font Manager");
+
+    static FT_Library library;
+    static std::unordered_map<std::string, std::unique_ptr<FontFile>> files; // keyed by absolute path
+
+public:
+    static FT_Library get_library() {
+        if (!library && FT_Init_FreeType(&library)) {
+            logger.log(Logger::CRITICAL) << "ERROR: Failed to init FreeType library";
+            library = nullptr;
+        }
+        return library;
+    }
+
+    // maps the font file on first use, every acquire must be paired with a release, nullptr if the file can not be read
+    static FontFile * acquire(const std::filesystem::path & path) {
+        std::string key = std::filesystem::absolute(path).lexically_normal().string();
+        auto it = files.find(key);
+        if (it == files.end()) {
+            auto file = std::make_unique<FontFile>(path);
+            if (!file->file.is_open()) {
+                logger.log(Logger::CRITICAL) << "ERROR: Failed to open font file: " << key;
+                return nullptr;
+            }
+            file->key = key;
+            it = files.emplace(key, std::move(file)).first;
+            logger << "Font file mapped: " << key;
+        }
+        it->second->users++;
+        return it->second.get();
+    }
+
+    // unmaps the file and frees its face once its last user is gone, the library goes with the last file
+    static void release(FontFile * file) {
+        if (!file || --file->users) return;
+        logger << "Font file released: " << file->key;
+        files.erase(file->key);
+        destroy();
+    }
+
+    // FT_Face of an acquired file, nullptr if FreeType can not parse it
+    static FT_Face get_face(FontFile * file) {
+        if (!file || !get_library()) return nullptr;
+        return file->get_face(library);
+    }
+
+    // frees the library once every file is released, get_library() initializes it again when another font is opened
+    static void destroy() {
+        if (!files.empty() || !library) return;
+        FT_Done_FreeType(library);
+        library = nullptr;
+        logger << "FreeType library freed";
+    }
+};
+}
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include <glm/glm.hpp>
+
+#include <GLFWE/texture.hpp>
+
+#include <GLFWE/text/glyph_cache.hpp>
+
+#include <logger/logger.hpp>
+
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+namespace GLFWE::Text {
+/*
+single channel texture that the glyphs of a font are packed into
+glyphs are placed on horizontal shelves, the atlas grows downwards when no shelf has room
+once it reaches max_height, the least recently used shelf is emptied and reused
+pixels are kept on the cpu, changed rows are uploaded by flush()
+*/
+class GlyphAtlas {
+protected:
+    static constexpr Logger logger = Logger("Glyph Atlas");
+
+    static constexpr int padding = 1; // empty texels between glyphs so linear filtering does not bleed
+
+    struct Shelf {
+        int y;                        // top of the shelf
+        int height;                   // tallest glyph the shelf can hold
+        int x;                        // next free column
+        unsigned int last_used;       // use tick of the most recent glyph lookup, UINT_MAX when pinned
+        std::vector<char32_t> owners; // codes of the glyphs packed on this shelf
+    };
+
+    GLFWE::Texture texture;
+    std::vector<unsigned char> pixels;
+    glm::ivec2 dimensions;
+    int max_height;
+    std::vector<Shelf> shelves;
+
+    unsigned int tick = 0;       // advanced once per use of the atlas, see begin_use()
+    unsigned int generation = 0; // advanced whenever glyphs are evicted
+    unsigned int holds = 0;      // begin_use() is ignored while held, see hold_use()
+
+    // rows [dirty_top, dirty_bottom) changed since the last flush
+    int dirty_top = INT_MAX, dirty_bottom = 0;
+    bool texture_resized = true;
+
+    std::function<void(char32_t)> on_evict;
+
+public:
+    GlyphAtlas(int width = 512, int initial_height = 64, int _max_height = 4096):
+    dimensions(width, initial_height), max_height(_max_height) {
+        pixels.resize(dimensions.x * dimensions.y, 0);
+    }
+
+    GlyphAtlas(GlyphAtlas & other) = delete;
+    GlyphAtlas(GlyphAtlas && other) = default;
+
+    // called with the code of every glyph that loses its place in the atlas
+    void set_eviction_callback(std::function<void(char32_t)> callback) {
+        on_evict = std::move(callback);
+    }
+
+    /*
+    starts a new use of the atlas (usually one string)
+    shelves touched during the current use are never evicted
+    */
+    void begin_use() {
+        if (holds == 0) tick++;
+    }
+
+    /*
+    starts a use that lasts until the matching release_use(), nested begin_use() calls join it
+    no glyph looked up in between can be evicted by a later lookup before the release
+    */
+    void hold_use() {
+        if (holds++ == 0) tick++;
+    }
+
+    void release_use() {
+        if (holds) holds--;
+    }
+
+    // changes with every begin_use()
+    unsigned int get_use() {
+        return tick;
+    }
+
+    void touch(unsigned int shelf) {
+        if (shelves[shelf].last_used != UINT_MAX) shelves[shelf].last_used = tick;
+    }
+
+    // keeps a shelf from ever being evicted
+    void pin(unsigned int shelf) {
+        shelves[shelf].last_used = UINT_MAX;
+    }
+
+    /*
+    packs a glyph bitmap into the atlas
+    on success, uv is set to the texel rectangle (left, top, right, bottom) and shelf to the shelf holding it
+    fails when the atlas is at its maximum size and every shelf was used since the last begin_use()
+    */
+    bool insert(char32_t owner, glm::ivec2 size, const unsigned char * data, int pitch, glm::ivec4 & uv, unsigned int & shelf) {
+        glm::ivec2 position;
+        if (!allocate(size, position, shelf)) return false;
+
+        shelves[shelf].owners.push_back(owner);
+        if (size.x == 0 || size.y == 0) {
+            uv = glm::ivec4(0);
+            return true;
+        }
+
+        for (int row = 0; row < size.y; row++) {
+            std::memcpy(&pixels[(position.y + row) * dimensions.x + position.x], data + row * pitch, size.x);
+        }
+        mark_dirty(position.y, position.y + size.y);
+
+        uv = glm::ivec4(position.x, position.y, position.x + size.x, position.y + size.y);
+        return true;
+    }
+
+    // uploads whatever changed since the last flush
+    void flush() {
+        if (texture_resized) {
+            texture.buffer_image_2D(0, GL_RED, dimensions.x, dimensions.y, GL_RED, GL_UNSIGNED_BYTE, pixels.data(), 1);
+            texture.set_wrapping_behavior(WRAP_CLAMP_EDGE).set_filtering_behavior(FILTER_LINEAR);
+            logger << "Atlas texture " << texture.id() << " uploaded (" << dimensions.x << "x" << dimensions.y << ", " << shelves.size() << " shelves)";
+        } else if (dirty_top < dirty_bottom) {
+            texture.buffer_sub_image_2D(0, 0, dirty_top, dimensions.x, dirty_bottom - dirty_top, GL_RED, GL_UNSIGNED_BYTE, &pixels[dirty_top * dimensions.x], 1);
+        }
+        texture_resized = false;
+        dirty_top = INT_MAX;
+        dirty_bottom = 0;
+    }
+
+    void bind() {
+        texture.bind();
+    }
+
+    glm::ivec2 get_dimensions() {
+        return dimensions;
+    }
+
+    // changes whenever previously returned uv rectangles may have become invalid
+    unsigned int get_generation() {
+        return generation;
+    }
+
+    // writes the size, shelves and pixels of the atlas
+    void serialize(CacheWriter & out) {
+        out.write<int32_t>(dimensions.x);
+        out.write<int32_t>(dimensions.y);
+        out.write<uint32_t>(shelves.size());
+        for (Shelf & shelf : shelves) {
+            out.write<int32_t>(shelf.y);
+            out.write<int32_t>(shelf.height);
+            out.write<int32_t>(shelf.x);
+            out.write<uint8_t>(shelf.last_used == UINT_MAX);
+            out.write<uint32_t>(shelf.owners.size());
+            out.write(shelf.owners.data(), sizeof(char32_t) * shelf.owners.size());
+        }
+        out.write(pixels.data(), pixels.size());
+    }
+
+    /*
+    replaces the atlas with one written by serialize, the texture is uploaded on the next flush
+    accept is called with the restored size and shelf count before anything changes, returning false rejects the cache
+    */
+    bool deserialize(CacheReader & in, const std::function<bool(glm::ivec2, unsigned int)> & accept = nullptr) {
+        // read one at a time, the order arguments are evaluated in is unspecified
+        glm::ivec2 new_dimensions;
+        new_dimensions.x = in.read<int32_t>();
+        new_dimensions.y = in.read<int32_t>();
+        if (new_dimensions.x <= 0 || new_dimensions.y <= 0 || new_dimensions.y > max_height) return false;
+
+        uint32_t shelf_count = in.read<uint32_t>();
+        if (shelf_count > (uint32_t) new_dimensions.y) return false;
+
+        std::vector<Shelf> new_shelves(shelf_count);
+        for (Shelf & shelf : new_shelves) {
+            shelf.y = in.read<int32_t>();
+            shelf.height = in.read<int32_t>();
+            shelf.x = in.read<int32_t>();
+            shelf.last_used = in.read<uint8_t>() ? UINT_MAX : 0;
+            uint32_t owner_count = in.read<uint32_t>();
+            const char32_t * owners = (const char32_t *) in.read(sizeof(char32_t) * (size_t) owner_count);
+            if (!in.good()) return false;
+            if (shelf.y < 0 || shelf.height < 0 || (long) shelf.y + shelf.height > new_dimensions.y || shelf.x < 0 || shelf.x > new_dimensions.x) return false;
+            shelf.owners.assign(owners, owners + owner_count);
+        }
+
+        const unsigned char * new_pixels = in.read((size_t) new_dimensions.x * new_dimensions.y);
+        if (!in.good()) return false;
+        if (accept && !accept(new_dimensions, shelf_count)) return false;
+
+        dimensions = new_dimensions;
+        shelves = std::move(new_shelves);
+        pixels.assign(new_pixels, new_pixels + dimensions.x * dimensions.y);
+        texture_resized = true;
+        generation++;
+        return true;
+    }
+
+protected:
+    bool allocate(glm::ivec2 size, glm::ivec2 & position, unsigned int & shelf_index) {
+        if (size.x + 2 * padding > dimensions.x || size.y + 2 * padding > max_height) {
+            logger.log(Logger::CRITICAL) << "Glyph of size " << size.x << "x" << size.y << " does not fit in an atlas of " << dimensions.x << "x" << max_height;
+            return false;
+        }
+
+        // best fit: the shortest existing shelf that is tall and wide enough
+        int best = -1;
+        for (unsigned int i = 0; i < shelves.size(); i++) {
+            if (shelves[i].height < size.y || shelves[i].x + size.x + padding > dimensions.x) continue;
+            if (best == -1 || shelves[i].height < shelves[best].height) best = i;
+        }
+
+        // open a new shelf under the last one, growing the atlas if possible
+        if (best == -1) {
+            int y = shelves.empty() ? padding : shelves.back().y + shelves.back().height + padding;
+            while (y + size.y + padding > dimensions.y && dimensions.y < max_height) grow();
+            if (y + size.y + padding <= dimensions.y) {
+                shelves.push_back({y, size.y, padding, tick, {}});
+                best = shelves.size() - 1;
+            }
+        }
+
+        // out of space, empty the least recently used shelf that can hold the glyph
+        if (best == -1) {
+            for (unsigned int i = 0; i < shelves.size(); i++) {
+                if (shelves[i].height < size.y || shelves[i].last_used >= tick) continue;
+                if (best == -1 || shelves[i].last_used < shelves[best].last_used) best = i;
+            }
+            if (best == -1) {
+                logger.log(Logger::WARNING) << "Atlas is full and every shelf is in use";
+                return false;
+            }
+            evict(best);
+        }
+
+        Shelf & shelf = shelves[best];
+        position = glm::ivec2(shelf.x, shelf.y);
+        shelf.x += size.x + padding;
+        shelf.last_used = std::max(shelf.last_used, tick);
+        shelf_index = best;
+        return true;
+    }
+
+    void evict(unsigned int shelf_index) {
+        Shelf & shelf = shelves[shelf_index];
+        for (char32_t owner : shelf.owners) {
+            if (on_evict) on_evict(owner);
+        }
+        shelf.owners.clear();
+        shelf.x = padding;
+
+        for (int row = shelf.y; row < shelf.y + shelf.height; row++) {
+            std::memset(&pixels[row * dimensions.x], 0, dimensions.x);
+        }
+        mark_dirty(shelf.y, shelf.y + shelf.height);
+        generation++;
+    }
+
+    void grow() {
+        dimensions.y = std::min(dimensions.y * 2, max_height);
+        pixels.resize(dimensions.x * dimensions.y, 0); // rows are contiguous, so existing glyphs keep their texels
+        texture_resized = true;
+    }
+
+    void mark_dirty(int top, int bottom) {
+        dirty_top = std::min(dirty_top, top);
+        dirty_bottom = std::max(dirty_bottom, bottom);
+    }
+};
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+
+namespace GLFWE::Text {
+/*
+helpers for the binary glyph cache written by CharacterSet::save_cache
+values are stored in native byte order, cache files are meant for the machine that wrote them
+*/
+class CacheWriter {
+public:
+    std::vector<unsigned char> bytes;
+
+    template<typename T>
+    void write(const T & value) {
+        write(&value, sizeof(T));
+    }
+    void write(const void * data, size_t size) {
+        const unsigned char * begin = (const unsigned char *) data;
+        bytes.insert(bytes.end(), begin, begin + size);
+    }
+};
+
+class CacheReader {
+protected:
+    const unsigned char * cursor;
+    const unsigned char * end;
+    bool failed = false;
+
+public:
+    CacheReader(const unsigned char * data, size_t size):
+    cursor(data), end(data + size) {}
+
+    template<typename T>
+    T read() {
+        T value{};
+        const unsigned char * source = read(sizeof(T));
+        if (source) std::memcpy(&value, source, sizeof(T));
+        return value;
+    }
+    // returns a pointer to the next size bytes, or nullptr if the data is too short
+    const unsigned char * read(size_t size) {
+        if (failed || (size_t) (end - cursor) < size) {
+            failed = true;
+            return nullptr;
+        }
+        const unsigned char * data = cursor;
+        cursor += size;
+        return data;
+    }
+
+    bool good() {
+        return !failed;
+    }
+};
+
+// everything a cached atlas depends on
+struct GlyphCacheKey {
+    static constexpr uint32_t magic = 0x47434647; // "GFCG"
+    static constexpr uint32_t version = 2;
+
+    std::string font_path;
+    uint64_t font_hash;
+    uint32_t font_height, lower, upper, render_mode;
+
+    std::string file_name() const {
+        uint64_t value = 14695981039346656037ull;
+        auto mix = [&value](const void * data, size_t size) {
+            for (size_t i = 0; i < size; i++) value = (value ^ ((const unsigned char *) data)[i]) * 1099511628211ull;
+        };
+        mix(font_path.data(), font_path.size());
+        mix(&font_hash, sizeof(font_hash));
+        mix(&font_height, sizeof(font_height));
+        mix(&lower, sizeof(lower));
+        mix(&upper, sizeof(upper));
+        mix(&render_mode, sizeof(render_mode));
+
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.glyphs", (unsigned long long) value);
+        return name;
+    }
+
+    void write(CacheWriter & out) const {
+        out.write(magic);
+        out.write(version);
+        out.write(font_hash);
+        out.write(font_height);
+        out.write(lower);
+        out.write(upper);
+        out.write(render_mode);
+        out.write((uint32_t) font_path.size());
+        out.write(font_path.data(), font_path.size());
+    }
+
+    // reads a key written by write() and compares it against this one
+    bool matches(CacheReader & in) const {
+        if (in.read<uint32_t>() != magic || in.read<uint32_t>() != version) return false;
+        if (in.read<uint64_t>() != font_hash) return false;
+        if (in.read<uint32_t>() != font_height || in.read<uint32_t>() != lower || in.read<uint32_t>() != upper || in.read<uint32_t>() != render_mode) return false;
+
+        uint32_t path_length = in.read<uint32_t>();
+        const unsigned char * path = in.read(path_length);
+        return in.good() && path_length == font_path.size() && std::memcmp(path, font_path.data(), path_length) == 0;
+    }
+};
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <GLFWE/color.hpp>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define GLFWE_TEXT_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace GLFWE::Text {
+struct GlyphVertex {
+    glm::vec2    position;
+    glm::vec2    texcoord; // in atlas texels
+    unsigned int color;    // rgba8, multiplied with the color passed to the draw call
+};
+
+/*
+writes the two triangles of one glyph to out[0..6)
+quad is the glyph's left, bottom, right, top at scale 1 relative to the pen, texels its atlas left, top, right, bottom
+every corner is a single multiply-add, done for all four edges at once where SSE is available
+*/
+inline void write_glyph_quad(GlyphVertex * out, glm::vec2 pen, float scale, const glm::vec4 & quad, const glm::vec4 & texels, unsigned int color) {
+#ifdef GLFWE_TEXT_SSE
+    static_assert(sizeof(GlyphVertex) == 5 * sizeof(float), "GlyphVertex is written as four floats and a color");
+
+    __m128 corners = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&quad.x), _mm_set1_ps(scale)), _mm_setr_ps(pen.x, pen.y, pen.x, pen.y));
+    __m128 uv = _mm_loadu_ps(&texels.x);
+
+    // (x, y, u, v) of the top left, bottom left, bottom right and top right corners
+    __m128 top_left     = _mm_shuffle_ps(corners, uv, _MM_SHUFFLE(1, 0, 3, 0));
+    __m128 bottom_left  = _mm_shuffle_ps(corners, uv, _MM_SHUFFLE(3, 0, 1, 0));
+    __m128 bottom_right = _mm_shuffle_ps(corners, uv, _MM_SHUFFLE(3, 2, 1, 2));
+    __m128 top_right    = _mm_shuffle_ps(corners, uv, _MM_SHUFFLE(1, 2, 3, 2));
+
+    _mm_storeu_ps(&out[0].position.x, top_left);
+    _mm_storeu_ps(&out[1].position.x, bottom_left);
+    _mm_storeu_ps(&out[2].position.x, bottom_right);
+    _mm_storeu_ps(&out[3].position.x, top_left);
+    _mm_storeu_ps(&out[4].position.x, bottom_right);
+    _mm_storeu_ps(&out[5].position.x, top_right);
+    for (int i = 0; i < 6; i++) out[i].color = color;
+#else
+    glm::vec4 corners = quad * scale + glm::vec4(pen, pen);
+
+    out[0] = {{corners.x, corners.w}, {texels.x, texels.y}, color};
+    out[1] = {{corners.x, corners.y}, {texels.x, texels.w}, color};
+    out[2] = {{corners.z, corners.y}, {texels.z, texels.w}, color};
+
+    out[3] = out[0];
+    out[4] = out[2];
+    out[5] = {{corners.z, corners.w}, {texels.z, texels.y}, color};
+#endif
+}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <GLFWE/text/glyph_cache.hpp>
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <climits>
+
+namespace GLFWE::Text {
+/*
+caches kerning offsets (in 1/64 pixels) between pairs of codes
+pairs inside a small indexed range live in a flat table, the rest in a hash map
+*/
+class KerningTable {
+protected:
+    static constexpr int16_t UNKNOWN = INT16_MIN;
+    static constexpr unsigned int max_dense_range = 256; // 128 KiB of int16 pairs
+
+    unsigned int lower, range;
+    std::vector<int16_t> dense;                        // range * range entries, allocated on first use
+    std::unordered_map<uint64_t, int16_t> sparse;
+
+public:
+    KerningTable(unsigned int _lower, unsigned int _upper):
+    lower(_lower), range(_upper - _lower <= max_dense_range ? _upper - _lower : 0) {}
+
+    // true and sets value if the pair was stored before
+    bool find(char32_t left, char32_t right, int & value) {
+        int16_t stored = UNKNOWN;
+        unsigned int l = left - lower, r = right - lower;
+        if (l < range && r < range) {
+            if (!dense.empty()) stored = dense[l * range + r];
+        } else {
+            auto it = sparse.find(key(left, right));
+            if (it != sparse.end()) stored = it->second;
+        }
+        if (stored == UNKNOWN) return false;
+        value = stored;
+        return true;
+    }
+
+    void store(char32_t left, char32_t right, int value) {
+        int16_t clamped = value < INT16_MIN + 1 ? INT16_MIN + 1 : value > INT16_MAX ? INT16_MAX : value;
+        unsigned int l = left - lower, r = right - lower;
+        if (l < range && r < range) {
+            if (dense.empty()) dense.assign(range * range, UNKNOWN);
+            dense[l * range + r] = clamped;
+        } else {
+            sparse[key(left, right)] = clamped;
+        }
+    }
+
+    void serialize(CacheWriter & out) {
+        std::vector<uint32_t> pairs; // left, right, value triples
+        for (unsigned int i = 0; i < dense.size(); i++) {
+            if (dense[i] == UNKNOWN) continue;
+            pairs.insert(pairs.end(), {lower + i / range, lower + i % range, (uint32_t) (int32_t) dense[i]});
+        }
+        for (auto & [pair, value] : sparse) {
+            pairs.insert(pairs.end(), {(uint32_t) (pair >> 32), (uint32_t) pair, (uint32_t) (int32_t) value});
+        }
+        out.write<uint32_t>(pairs.size() / 3);
+        out.write(pairs.data(), sizeof(uint32_t) * pairs.size());
+    }
+
+    bool deserialize(CacheReader & in) {
+        uint32_t count = in.read<uint32_t>();
+        const uint32_t * pairs = (const uint32_t *) in.read(sizeof(uint32_t) * 3 * (size_t) count);
+        if (!in.good()) return false;
+        for (uint32_t i = 0; i < count; i++) {
+            store(pairs[i * 3], pairs[i * 3 + 1], (int32_t) pairs[i * 3 + 2]);
+        }
+        return true;
+    }
+
+protected:
+    static uint64_t key(char32_t left, char32_t right) {
+        return (uint64_t) left << 32 | right;
+    }
+};
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <GLFWE/vertex_array.hpp>
+
+#include <GLFWE/text/character_set.hpp>
+
+#include <logger/logger.hpp>
+
+#include <array>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace GLFWE::Text {
+/*
+a number (after an optional constant ascii prefix) that changes every frame, e.g. fps counters or timers
+values are formatted with std::to_chars into a fixed buffer, every character owns one quad slot of a small
+persistent vertex buffer, and an update only uploads the slots whose character or pen position changed
+updating and drawing never allocate
+glyphs are placed without kerning, digits of most fonts have equal advances anyway
+the font must outlive the label
+*/
+class NumericLabel {
+public:
+    static constexpr unsigned int max_chars = 48;
+
+protected:
+    static constexpr Logger logger = Logger("Numeric Label");
+
+    CharacterSet & font;
+    glm::vec2 position;
+    float scale;
+    glm::vec3 color;
+    int precision; // digits after the point for floating point values, -1 for the shortest exact form
+
+    std::array<char, max_chars> chars{};      // characters currently in the slots
+    std::array<float, max_chars> pens{};      // pen x of every slot
+    std::array<GlyphVertex, max_chars * 6> vertices;
+    unsigned int length = 0;
+    unsigned int prefix_length = 0;
+
+    GLFWE::VertexArray VAO;
+    unsigned int atlas_generation = 0;
+
+public:
+    NumericLabel(CharacterSet & _font, const std::string & prefix, glm::vec2 _position, float _scale = 1.0f, glm::vec3 _color = {1, 1, 1}, int _precision = -1):
+    font(_font), position(_position), scale(_scale), color(_color), precision(_precision) {
+        VAO.buffer_vertex_data(sizeof(vertices), nullptr, DYNAMIC_DRAW);
+        CharacterSet::assign_vertex_attributes(VAO);
+
+        prefix_length = std::min<size_t>(prefix.size(), max_chars / 2);
+        if (prefix_length < prefix.size()) logger.log(Logger::WARNING) << "Prefix \"" << prefix << "\" is cut to " << prefix_length << " characters";
+
+        std::array<char, max_chars> initial;
+        std::memcpy(initial.data(), prefix.data(), prefix_length);
+        initial[prefix_length] = '0';
+        update(initial.data(), prefix_length + 1, true);
+    }
+
+    NumericLabel(NumericLabel & other) = delete;
+    NumericLabel(NumericLabel && other) = default;
+
+    // any integer or floating point value
+    template<typename T>
+    void set_value(T value) {
+        static_assert(std::is_arithmetic_v<T>, "NumericLabel only shows numbers");
+
+        std::array<char, max_chars> text;
+        std::memcpy(text.data(), chars.data(), prefix_length);
+        char * begin = text.data() + prefix_length, * end = text.data() + max_chars;
+
+        std::to_chars_result result;
+        if constexpr (std::is_integral_v<T>) result = std::to_chars(begin, end, value);
+        else if (precision < 0) result = std::to_chars(begin, end, value);
+        else result = std::to_chars(begin, end, value, std::chars_format::fixed, precision);
+
+        if (result.ec != std::errc()) {
+            // too long for the buffer, better an obviously wrong label than a stale one
+            *begin = '#';
+            result.ptr = begin + 1;
+        }
+        update(text.data(), result.ptr - text.data(), false);
+    }
+
+    void set_precision(int new_precision) {
+        precision = new_precision;
+    }
+    void set_position(glm::vec2 new_position) {
+        position = new_position;
+    }
+    void set_color(glm::vec3 new_color) {
+        color = new_color;
+    }
+
+    glm::vec2 get_position() { return position; }
+    glm::vec3 get_color() { return color; }
+
+    // width of the current text, in pixels
+    float get_width() {
+        if (length == 0) return 0;
+        return pens[length - 1] + font.get_ascii_quad(chars[length - 1]).advance * scale;
+    }
+
+    void draw() {
+        // evicted glyphs invalidate every slot
+        if (atlas_generation != font.get_atlas_generation()) update(chars.data(), length, true);
+        font.draw_vertex_array(VAO, length * 6, position, color);
+    }
+
+protected:
+    /*
+    lays text out into the slots and uploads the range of slots that changed
+    every slot is rewritten when glyphs were evicted since the last update, or while this one looked glyphs up
+    */
+    void update(const char * text, unsigned int new_length, bool force) {
+        unsigned int first_changed = new_length, last_changed = 0;
+        unsigned int generation;
+
+        do {
+            generation = font.get_atlas_generation();
+            force = force || generation != atlas_generation;
+            float pen = 0;
+
+            for (unsigned int i = 0; i < new_length; i++) {
+                const GlyphQuad & quad = font.get_ascii_quad(text[i]);
+                if (force || i >= length || chars[i] != text[i] || pens[i] != pen) {
+                    chars[i] = text[i];
+                    pens[i] = pen;
+                    write_slot(i, quad, pen);
+                    first_changed = std::min(first_changed, i);
+                    last_changed = std::max(last_changed, i + 1);
+                }
+                pen += quad.advance * scale;
+            }
+            atlas_generation = generation;
+        } while (font.get_atlas_generation() != generation);
+        length = new_length;
+
+        if (first_changed < last_changed) {
+            VAO.buffer_vertex_sub_data(sizeof(GlyphVertex) * first_changed * 6, sizeof(GlyphVertex) * (last_changed - first_changed) * 6, &vertices[first_changed * 6]);
+        }
+    }
+
+    void write_slot(unsigned int slot, const GlyphQuad & quad, float pen) {
+        write_glyph_quad(&vertices[slot * 6], glm::vec2(pen, 0.0f), scale, quad.quad, quad.texels, 0xFFFFFFFF);
+    }
+};
+}
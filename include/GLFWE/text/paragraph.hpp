@@ -0,0 +1,276 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <GLFWE/vertex_array.hpp>
+#include <GLFWE/range_allocator.hpp>
+
+#include <GLFWE/text/character_set.hpp>
+
+#include <logger/logger.hpp>
+
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace GLFWE::Text {
+/*
+multi line, word wrapped text meant for large editable buffers
+every line keeps its own vertices (relative to its baseline) in a range of one shared vertex buffer,
+an edit only re-wraps lines until the new line breaks line up with the old ones again,
+and only those lines are rebuilt and uploaded
+position is the baseline of the first line, the font must outlive the paragraph
+*/
+class Paragraph {
+protected:
+    static constexpr Logger logger = Logger("Paragraph");
+
+    struct Line {
+        size_t begin, end;                  // bytes of text, end includes the '\n' that ends the line
+        std::vector<GlyphVertex> vertices;  // kept so the buffer can be reallocated without a relayout
+        unsigned int first_vertex = 0;
+        bool dirty = true;
+    };
+
+    CharacterSet & font;
+    std::string text;
+    glm::vec2 position;
+    float wrap_width;
+    float scale;
+    glm::vec3 color;
+
+    std::vector<Line> lines;
+
+    GLFWE::VertexArray VAO;
+    RangeAllocator allocator; // in vertices
+    unsigned int atlas_generation = 0;
+
+    std::vector<VertexRange> ranges; // scratch space reused by draw
+
+public:
+    Paragraph(CharacterSet & _font, const std::string & _text, glm::vec2 _position, float _wrap_width = 0.0f, float _scale = 1.0f, glm::vec3 _color = {1, 1, 1}):
+    font(_font), text(_text), position(_position), wrap_width(_wrap_width), scale(_scale), color(_color) {
+        CharacterSet::assign_vertex_attributes(VAO);
+        relayout();
+    }
+
+    Paragraph(Paragraph & other) = delete;
+    Paragraph(Paragraph && other) = default;
+
+    void set_text(const std::string & new_text) {
+        if (new_text == text) return;
+        text = new_text;
+        relayout();
+    }
+
+    // replaces count bytes at offset, offsets must be on utf-8 character boundaries
+    void replace(size_t offset, size_t count, const std::string & replacement) {
+        offset = std::min(offset, text.size());
+        count = std::min(count, text.size() - offset);
+
+        /*
+        a shorter first word can move back onto the line before, unless that line ended with a '\n'
+        a word broken mid-word reaches back further, every line it runs through can wrap differently
+        */
+        size_t first = line_at(offset);
+        if (first > 0 && !ends_with_newline(first - 1)) first--;
+        while (first > 0 && !ends_with_newline(first - 1) && (ends_mid_word(first - 1) || ends_mid_word(first))) first--;
+
+        text.replace(offset, count, replacement);
+        relayout_from(first, offset + count, (long) replacement.size() - (long) count);
+
+#ifdef GLFWE_PARAGRAPH_CHECKS
+        if (!verify_layout()) logger.log(Logger::CRITICAL) << "Line breaks after replace(" << offset << ", " << count << ") differ from a full relayout";
+#endif
+    }
+    void insert(size_t offset, const std::string & inserted) {
+        replace(offset, 0, inserted);
+    }
+    void erase(size_t offset, size_t count) {
+        replace(offset, count, "");
+    }
+
+    // 0 disables wrapping
+    void set_wrap_width(float new_wrap_width) {
+        if (new_wrap_width == wrap_width) return;
+        wrap_width = new_wrap_width;
+        relayout();
+    }
+    void set_scale(float new_scale) {
+        if (new_scale == scale) return;
+        scale = new_scale;
+        relayout();
+    }
+    void set_position(glm::vec2 new_position) {
+        position = new_position;
+    }
+    void set_color(glm::vec3 new_color) {
+        color = new_color;
+    }
+
+    const std::string & get_text() { return text; }
+    glm::vec2 get_position() { return position; }
+    float get_wrap_width() { return wrap_width; }
+    float get_scale() { return scale; }
+    glm::vec3 get_color() { return color; }
+
+    unsigned int get_line_count() {
+        return lines.size();
+    }
+    // bytes [begin, end) of text shown on a line, including the '\n' that ends it
+    glm::uvec2 get_line_bytes(unsigned int line) {
+        return glm::uvec2(lines[line].begin, lines[line].end);
+    }
+    float get_line_height() {
+        return font.get_line_height() * scale;
+    }
+
+    // index of the line showing the byte at offset
+    unsigned int line_at(size_t offset) {
+        auto it = std::upper_bound(lines.begin(), lines.end(), offset, [](size_t value, const Line & line) { return value < line.begin; });
+        return it == lines.begin() ? 0 : it - lines.begin() - 1;
+    }
+
+    void draw() {
+        draw_lines(0, lines.size());
+    }
+
+    // only draws (and builds) the lines that can reach into the band visible_bottom <= y <= visible_top
+    void draw(float visible_bottom, float visible_top) {
+        float line_height = get_line_height();
+        if (line_height <= 0) return draw();
+
+        float first = std::floor((position.y - visible_top) / line_height) - 1;
+        float last = std::ceil((position.y - visible_bottom) / line_height) + 1;
+        draw_lines(std::clamp(first, 0.0f, (float) lines.size()), std::clamp(last + 1, 0.0f, (float) lines.size()));
+    }
+
+    /*
+    true if the lines match a full relayout of the text, for checking edits
+    only compares line breaks, nothing is built or uploaded
+    */
+    bool verify_layout() {
+        size_t begin = 0;
+        for (size_t i = 0; i < lines.size(); i++) {
+            if (lines[i].begin != begin) return false;
+            size_t end = font.wrap_line(text, begin, wrap_width, scale);
+            if (lines[i].end != end) return false;
+            begin = end;
+        }
+        // the last line has to reach the end, unless a '\n' there starts one more empty line
+        return lines.back().end == text.size() && !(text.size() > lines.back().begin && text.back() == '\n');
+    }
+
+protected:
+    bool ends_with_newline(size_t line) {
+        return lines[line].end > lines[line].begin && text[lines[line].end - 1] == '\n';
+    }
+    // the line was cut inside a word that did not fit, rather than after a space
+    bool ends_mid_word(size_t line) {
+        if (line + 1 >= lines.size() || lines[line].end == lines[line].begin) return false;
+        char last = text[lines[line].end - 1];
+        return last != ' ' && last != '\n';
+    }
+
+    void relayout() {
+        for (Line & line : lines) allocator.free(line.first_vertex, line.vertices.size());
+        lines.clear();
+        lines.push_back({0, 0});
+        relayout_from(0, 0, 0);
+    }
+
+    /*
+    re-wraps text from the start of lines[first] until a new line starts where an old line after the edit started
+    old_edit_end is the end of the replaced bytes before the edit, delta the change in text length
+    */
+    void relayout_from(size_t first, size_t old_edit_end, long delta) {
+        std::vector<Line> new_lines;
+        size_t begin = lines[first].begin;
+        size_t old = first;
+
+        while (true) {
+            size_t end = font.wrap_line(text, begin, wrap_width, scale);
+            new_lines.push_back({begin, end});
+
+            // a '\n' at the very end still starts one more, empty line
+            bool ends_text = end >= text.size() && !(end > begin && text[end - 1] == '\n');
+            if (ends_text || end == begin) {
+                old = lines.size();
+                break;
+            }
+            begin = end;
+
+            // old lines that start after the edit only depend on the text after them, reuse them once the breaks line up
+            while (old < lines.size() && (lines[old].begin < old_edit_end || (long) lines[old].begin + delta < (long) begin)) old++;
+            if (old < lines.size() && (long) lines[old].begin + delta == (long) begin) break;
+        }
+
+        for (size_t i = first; i < old; i++) allocator.free(lines[i].first_vertex, lines[i].vertices.size());
+        for (size_t i = old; i < lines.size(); i++) {
+            lines[i].begin += delta;
+            lines[i].end += delta;
+        }
+        lines.erase(lines.begin() + first, lines.begin() + old);
+        lines.insert(lines.begin() + first, std::make_move_iterator(new_lines.begin()), std::make_move_iterator(new_lines.end()));
+    }
+
+    void draw_lines(size_t first, size_t last) {
+        float line_height = get_line_height();
+
+        // the lines rebuilt here share one use of the atlas, but a rebuild can still evict the glyphs of a clean line
+        // when that happens the pass is run once more, rebuilding every visible line
+        font.hold_atlas_use();
+        for (int pass = 0; pass < 2; pass++) {
+            // evicted glyphs invalidate the uvs of every line
+            if (atlas_generation != font.get_atlas_generation()) {
+                for (Line & line : lines) line.dirty = true;
+                atlas_generation = font.get_atlas_generation();
+            }
+
+            ranges.clear();
+            for (size_t i = first; i < last; i++) {
+                Line & line = lines[i];
+                if (line.dirty) rebuild(line);
+                if (line.vertices.empty()) continue;
+                ranges.push_back({line.first_vertex, (unsigned int) line.vertices.size(), position - glm::vec2(0.0f, i * line_height)});
+            }
+            if (atlas_generation == font.get_atlas_generation()) break;
+        }
+        font.release_atlas_use();
+
+        font.draw_vertex_ranges(VAO, ranges, color);
+    }
+
+    void rebuild(Line & line) {
+        allocator.free(line.first_vertex, line.vertices.size());
+        line.vertices.clear();
+
+        size_t length = line.end - line.begin;
+        if (length && text[line.end - 1] == '\n') length--;
+        font.append_string_vertices(text.substr(line.begin, length), glm::vec2(0.0f), scale, line.vertices);
+
+        // the line stays dirty while growing, so its old offset is not uploaded to
+        if (!allocator.allocate(line.vertices.size(), line.first_vertex)) {
+            grow(line.vertices.size());
+            allocator.allocate(line.vertices.size(), line.first_vertex);
+        }
+        line.dirty = false;
+        if (line.vertices.empty()) return;
+        VAO.buffer_vertex_sub_data(sizeof(GlyphVertex) * line.first_vertex, line.vertices);
+    }
+
+    // reallocates the vertex buffer and uploads every clean line into it again, offsets are kept
+    void grow(unsigned int required) {
+        unsigned int capacity = std::max(allocator.get_capacity() * 2, allocator.get_capacity() + required);
+        capacity = std::max(capacity, 6u * 256u);
+        allocator.grow(capacity);
+
+        VAO.buffer_vertex_data(sizeof(GlyphVertex) * capacity, nullptr, DYNAMIC_DRAW);
+        for (Line & line : lines) {
+            if (!line.dirty && !line.vertices.empty()) VAO.buffer_vertex_sub_data(sizeof(GlyphVertex) * line.first_vertex, line.vertices);
+        }
+        logger << "Vertex buffer grown to " << capacity << " vertices";
+    }
+};
+}
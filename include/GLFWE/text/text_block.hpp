@@ -0,0 +1,102 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <GLFWE/vertex_array.hpp>
+
+#include <GLFWE/text/character_set.hpp>
+
+#include <logger/logger.hpp>
+
+#include <string>
+#include <vector>
+
+namespace GLFWE::Text {
+/*
+a string whose geometry stays on the gpu between frames
+vertices are only rebuilt when the text, spans or scale change (or the font atlas evicted glyphs),
+moving or recoloring the whole block only changes uniforms
+the font must outlive the block
+*/
+class TextBlock {
+protected:
+    static constexpr Logger logger = Logger("Text Block");
+
+    CharacterSet & font;
+    std::string text;
+    glm::vec2 position;
+    float scale;
+    glm::vec3 color;
+    std::vector<TextSpan> spans; // per glyph colors, multiplied with color
+
+    GLFWE::VertexArray VAO;
+    unsigned int vertex_count = 0;
+    unsigned int capacity = 0; // bytes allocated in the VAO buffer
+
+    bool dirty = true;
+    unsigned int atlas_generation = 0;
+
+public:
+    TextBlock(CharacterSet & _font, const std::string & _text, glm::vec2 _position, float _scale = 1.0f, glm::vec3 _color = {1, 1, 1}):
+    font(_font), text(_text), position(_position), scale(_scale), color(_color) {
+        CharacterSet::assign_vertex_attributes(VAO);
+    }
+
+    TextBlock(TextBlock & other) = delete;
+    TextBlock(TextBlock && other) = default;
+
+    void set_text(const std::string & new_text) {
+        if (new_text == text) return;
+        text = new_text;
+        dirty = true;
+    }
+    // spans must be sorted and must not overlap
+    void set_spans(const std::vector<TextSpan> & new_spans) {
+        spans = new_spans;
+        dirty = true;
+    }
+    void set_scale(float new_scale) {
+        if (new_scale == scale) return;
+        scale = new_scale;
+        dirty = true;
+    }
+    void set_position(glm::vec2 new_position) {
+        position = new_position;
+    }
+    void set_color(glm::vec3 new_color) {
+        color = new_color;
+    }
+
+    const std::string & get_text() { return text; }
+    glm::vec2 get_position() { return position; }
+    float get_scale() { return scale; }
+    glm::vec3 get_color() { return color; }
+    const std::vector<TextSpan> & get_spans() { return spans; }
+
+    void draw() {
+        if (dirty || atlas_generation != font.get_atlas_generation()) rebuild();
+        if (vertex_count == 0) return;
+        font.draw_vertex_array(VAO, vertex_count, position, color);
+    }
+
+protected:
+    void rebuild() {
+        std::vector<GlyphVertex> vertices;
+        font.append_styled_vertices(text, spans, glm::vec2(0.0f), scale, vertices);
+        vertex_count = vertices.size();
+        dirty = false;
+
+        // the text is laid out as a single use of the atlas, which never evicts its own glyphs, record the generation afterwards
+        atlas_generation = font.get_atlas_generation();
+        if (vertices.empty()) return;
+
+        unsigned int data_size = sizeof(GlyphVertex) * vertices.size();
+        if (data_size > capacity) {
+            capacity = data_size;
+            VAO.buffer_vertex_data(vertices, STATIC_DRAW);
+        } else {
+            VAO.buffer_vertex_sub_data(0, vertices);
+        }
+    }
+};
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <GLFWE/window.hpp>
+#include <GLFWE/texture.hpp>
+#include <GLFWE/framebuffer.hpp>
+#include <GLFWE/vertex_array.hpp>
+#include <GLFWE/shader.hpp>
+#include <GLFWE/shader_program.hpp>
+
+#include <GLFWE/text/character_set.hpp>
+
+#include <logger/logger.hpp>
+
+#include <string>
+#include <memory>
+#include <cmath>
+
+namespace GLFWE::Text {
+/*
+a string rendered once into its own texture and then drawn as a single quad, for long labels that rarely change
+the texture is rendered again only when the text, scale or color change, or after invalidate()
+it holds premultiplied alpha and is drawn with glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA),
+the caller's blend state is saved before the draw and restored after it
+the font must outlive the impostor
+*/
+class TextImpostor {
+protected:
+    static constexpr Logger logger = Logger("Text Impostor");
+
+    static constexpr int padding = 2; // transparent texels around the text so linear filtering has an edge to fade into
+
+    CharacterSet & font;
+    std::string text;
+    glm::vec2 position;
+    float scale;
+    glm::vec3 color;
+
+    GLFWE::Texture texture;
+    GLFWE::Framebuffer framebuffer;
+    glm::ivec2 texture_size = glm::ivec2(0);
+    glm::vec2 quad_offset = glm::vec2(0.0f); // from position to the bottom left of the texture
+    bool dirty = true;
+
+    static std::unique_ptr<GLFWE::VertexArray> VAO;
+    static std::unique_ptr<GLFWE::ShaderProgram> program;
+
+public:
+    TextImpostor(CharacterSet & _font, const std::string & _text, glm::vec2 _position, float _scale = 1.0f, glm::vec3 _color = {1, 1, 1}):
+    font(_font), text(_text), position(_position), scale(_scale), color(_color) {
+        if (VAO == nullptr) prepare_VAO_and_program();
+    }
+
+    TextImpostor(TextImpostor & other) = delete;
+    TextImpostor(TextImpostor && other) = default;
+
+    void set_text(const std::string & new_text) {
+        if (new_text == text) return;
+        text = new_text;
+        dirty = true;
+    }
+    void set_scale(float new_scale) {
+        if (new_scale == scale) return;
+        scale = new_scale;
+        dirty = true;
+    }
+    void set_color(glm::vec3 new_color) {
+        if (new_color == color) return;
+        color = new_color;
+        dirty = true;
+    }
+    void set_position(glm::vec2 new_position) {
+        position = new_position;
+    }
+
+    // renders the texture again on the next draw
+    void invalidate() {
+        dirty = true;
+    }
+
+    const std::string & get_text() { return text; }
+    glm::vec2 get_position() { return position; }
+    float get_scale() { return scale; }
+    glm::vec3 get_color() { return color; }
+
+    void draw() {
+        if (dirty) render();
+        if (texture_size.x == 0 || texture_size.y == 0) return;
+
+        glm::vec2 projection = CharacterSet::get_projection();
+        glm::mat4 projection_matrix = glm::ortho(0.0f, projection.x, 0.0f, projection.y);
+        glm::vec2 corner = position + quad_offset;
+
+        program->use();
+        glUniformMatrix4fv(program->get_uniform_location("projection"), 1, GL_FALSE, glm::value_ptr(projection_matrix));
+        glUniform4f(program->get_uniform_location("rect"), corner.x, corner.y, texture_size.x, texture_size.y);
+        texture.bind();
+
+        // the texels are premultiplied, the caller's blending is put back afterwards
+        BlendState previous_blend;
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        VAO->draw(GL_TRIANGLE_STRIP, 4, 0);
+        previous_blend.restore();
+    }
+
+protected:
+    // the caller's blend functions and whether blending is enabled, saved before a draw and put back by restore()
+    struct BlendState {
+        GLint source_rgb, destination_rgb, source_alpha, destination_alpha;
+        GLboolean enabled;
+
+        BlendState() {
+            glGetIntegerv(GL_BLEND_SRC_RGB, &source_rgb);
+            glGetIntegerv(GL_BLEND_DST_RGB, &destination_rgb);
+            glGetIntegerv(GL_BLEND_SRC_ALPHA, &source_alpha);
+            glGetIntegerv(GL_BLEND_DST_ALPHA, &destination_alpha);
+            enabled = glIsEnabled(GL_BLEND);
+        }
+
+        void restore() {
+            glBlendFuncSeparate(source_rgb, destination_rgb, source_alpha, destination_alpha);
+            if (enabled) glEnable(GL_BLEND);
+            else glDisable(GL_BLEND);
+        }
+    };
+
+    void render() {
+        dirty = false;
+
+        TextLayout layout = font.layout_string(text, glm::vec2(0.0f), scale);
+        glm::ivec2 low(std::floor(layout.bounds.x), std::floor(layout.bounds.y));
+        glm::ivec2 high(std::ceil(layout.bounds.z), std::ceil(layout.bounds.w));
+        glm::ivec2 size = high - low + glm::ivec2(2 * padding);
+        if (layout.glyphs.empty() || high.x <= low.x || high.y <= low.y) {
+            texture_size = glm::ivec2(0);
+            return;
+        }
+
+        // everything changed here, including the framebuffer bound by attach_texture, is put back afterwards
+        GLint viewport[4];
+        GLfloat clear_color[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        glGetFloatv(GL_COLOR_CLEAR_VALUE, clear_color);
+        BlendState previous_blend;
+        unsigned int previous_framebuffer = GLFWE::Framebuffer::get_bound();
+        glm::vec2 previous_projection = CharacterSet::get_projection();
+
+        // whole texel offsets keep the glyphs as sharp as when drawn directly
+        quad_offset = glm::vec2(low - glm::ivec2(padding));
+        if (size != texture_size) {
+            texture_size = size;
+            texture.buffer_image_2D(0, GL_RGBA8, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            texture.set_wrapping_behavior(WRAP_CLAMP_EDGE).set_filtering_behavior(FILTER_LINEAR);
+            framebuffer.attach_texture(texture);
+        }
+
+        framebuffer.bind();
+        glViewport(0, 0, size.x, size.y);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        // color is weighted by its alpha while alpha accumulates, leaving premultiplied texels
+        glEnable(GL_BLEND);
+        glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+        CharacterSet::set_projection(glm::vec2(size));
+        font.render_string(text, -quad_offset, scale, color);
+
+        CharacterSet::set_projection(previous_projection);
+        GLFWE::Framebuffer::bind_id(previous_framebuffer);
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        glClearColor(clear_color[0], clear_color[1], clear_color[2], clear_color[3]);
+        previous_blend.restore();
+
+        logger << "Rendered \"" << text << "\" into a " << size.x << "x" << size.y << " texture";
+    }
+
+    static void prepare_VAO_and_program() {
+        VAO = std::make_unique<GLFWE::VertexArray>();
+        program = std::make_unique<GLFWE::ShaderProgram>();
+
+        float unit_quad[4][2] = {{0, 0}, {1, 0}, {0, 1}, {1, 1}};
+        VAO->buffer_vertex_data(sizeof(unit_quad), unit_quad, STATIC_DRAW);
+        VAO->assign_vertex_attribute(0, 2, GL_FLOAT, GL_FALSE, 2*sizeof(float));
+
+        auto vertex_shader = GLFWE::Shader(VERTEX_SHADER);
+        vertex_shader.load_raw(
+            R"(#version 330 core
+            layout (location = 0) in vec2 corner;
+            out vec2 TexCoords;
+
+            uniform mat4 projection;
+            uniform vec4 rect;
+
+            void main()
+            {
+                gl_Position = projection * vec4(rect.xy + corner * rect.zw, 0.0, 1.0);
+                TexCoords = corner;
+        })");
+        auto fragment_shader = GLFWE::Shader(FRAGMENT_SHADER);
+        fragment_shader.load_raw(
+            R"(#version 330 core
+            in vec2 TexCoords;
+            out vec4 color;
+
+            uniform sampler2D image;
+
+            void main()
+            {
+                color = texture(image, TexCoords);
+            })"
+        );
+
+        program->attach_shader(vertex_shader).attach_shader(fragment_shader).link();
+    }
+};
+}
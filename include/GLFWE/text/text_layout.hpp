@@ -0,0 +1,38 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+#include <cstddef>
+
+namespace GLFWE::Text {
+struct GlyphPlacement {
+    char32_t  code;
+    glm::vec2 pen;     // origin of the glyph on the baseline
+    glm::vec4 rect;    // quad drawn for the glyph: left, bottom, width, height
+    float     advance; // how far the pen moved past the glyph, the fallback's for codes missing from the font
+};
+
+// positions computed by CharacterSet::layout_string, nothing here touches gl
+struct TextLayout {
+    std::vector<GlyphPlacement> glyphs;
+    glm::vec4 bounds = glm::vec4(0.0f); // union of every glyph quad: left, bottom, right, top
+    glm::vec2 end_pen = glm::vec2(0.0f); // where the next glyph would go
+    unsigned int lines = 0;
+};
+
+// size of a string without its glyph positions, see CharacterSet::measure_string
+struct TextMetrics {
+    float width = 0;                       // widest line, in advances
+    float height = 0;                      // lines * line height
+    glm::vec4 bounds = glm::vec4(0.0f);    // ink bounds relative to the start pen: left, bottom, right, top
+    unsigned int lines = 0;
+};
+
+// colors the bytes [begin, end) of a string, see CharacterSet::render_styled_string
+struct TextSpan {
+    size_t    begin;
+    size_t    end;
+    glm::vec4 color;
+};
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <string>
+
+namespace GLFWE::Text {
+    static constexpr char32_t REPLACEMENT_CHARACTER = 0xFFFD;
+
+    /*
+    decodes the utf-8 sequence starting at it and moves it past the sequence
+    malformed, overlong and surrogate sequences decode to REPLACEMENT_CHARACTER, consuming one byte
+    */
+    inline char32_t decode_utf8(std::string::const_iterator & it, std::string::const_iterator end) {
+        unsigned char lead = *it++;
+        if (lead < 0x80) return lead;
+
+        int length;
+        char32_t code;
+        if      ((lead & 0xE0) == 0xC0) { length = 1; code = lead & 0x1F; }
+        else if ((lead & 0xF0) == 0xE0) { length = 2; code = lead & 0x0F; }
+        else if ((lead & 0xF8) == 0xF0) { length = 3; code = lead & 0x07; }
+        else return REPLACEMENT_CHARACTER;
+
+        auto sequence_start = it;
+        for (int i = 0; i < length; i++) {
+            if (it == end || (*it & 0xC0) != 0x80) {
+                it = sequence_start;
+                return REPLACEMENT_CHARACTER;
+            }
+            code = (code << 6) | (*it++ & 0x3F);
+        }
+
+        static constexpr char32_t minimum[] = {0, 0x80, 0x800, 0x10000};
+        if (code < minimum[length] || code > 0x10FFFF || (code >= 0xD800 && code <= 0xDFFF)) {
+            it = sequence_start;
+            return REPLACEMENT_CHARACTER;
+        }
+        return code;
+    }
+}
@@ -69,6 +69,14 @@ public:
         return std::move(*this);
     }
 
+    // overwrites a region of an image previously buffered with buffer_image_2D, mipmaps are not regenerated
+    Texture && buffer_sub_image_2D(int mipmap_level, int x_offset, int y_offset, int width, int height, GLenum source_format, GLenum source_datatype, void* data, unsigned int pack_alignment = 4) {
+        bind();
+        glPixelStorei(GL_UNPACK_ALIGNMENT, pack_alignment);
+        glTexSubImage2D(GL_TEXTURE_2D, mipmap_level, x_offset, y_offset, width, height, source_format, source_datatype, data);
+        return std::move(*this);
+    }
+
     #define WRAP_REPEAT GL_REPEAT
     #define WRAP_MIRROR_REPEAT GL_MIRRORED_REPEAT
     #define WRAP_CLAMP_EDGE GL_CLAMP_TO_EDGE
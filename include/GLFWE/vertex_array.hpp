@@ -8,12 +8,17 @@
 
 #include <logger/logger.hpp>
 
+#include <memory>
+#include <cstdint>
+
 namespace GLFWE {
 class VertexArray {
 protected:
     static constexpr Logger logger = Logger("Vertex Array");
 
     Buffer vertex_buffer;
+    std::unique_ptr<Buffer> instance_buffer; // only created once instance data is buffered
+    std::unique_ptr<Buffer> index_buffer;    // only created once index data is buffered
     unsigned int glfw_vertex_array;
 
 public:
@@ -25,6 +30,8 @@ public:
     VertexArray(VertexArray & other) = delete;
     VertexArray(VertexArray && other): 
     vertex_buffer(std::move(other.vertex_buffer)),
+    instance_buffer(std::move(other.instance_buffer)),
+    index_buffer(std::move(other.index_buffer)),
     glfw_vertex_array(other.glfw_vertex_array) {
         other.glfw_vertex_array = 0;
     }
@@ -36,8 +43,12 @@ public:
     void destroy() {
         if (!glfw_vertex_array || Window::has_terminated()) return;
         vertex_buffer.destroy();
+        if (instance_buffer) instance_buffer->destroy();
+        if (index_buffer) index_buffer->destroy();
+        if (current_bound == glfw_vertex_array) current_bound = 0;
         glDeleteVertexArrays(1, &glfw_vertex_array);
         logger << "vertex array " << glfw_vertex_array << " destroyed";
+        glfw_vertex_array = 0;
     }
 
     unsigned int id() {
@@ -56,6 +67,18 @@ public:
         glDrawArrays(method, offset, length);
     }
 
+    // draws length vertices instance_count times, advancing the instance attributes once per instance
+    void draw_instanced(GLenum method, int length, int instance_count, int offset = 0) {
+        bind();
+        glDrawArraysInstanced(method, offset, length, instance_count);
+    }
+
+    // draws length unsigned int indices from the index buffer, starting at index offset
+    void draw_elements(GLenum method, int length, int offset = 0) {
+        bind();
+        glDrawElements(method, length, GL_UNSIGNED_INT, (const void*) (uintptr_t) (sizeof(unsigned int) * offset));
+    }
+
     #define STREAM_DRAW GL_STREAM_DRAW // set once & only used a few times
     #define STATIC_DRAW GL_STATIC_DRAW // set once & used many times
     #define DYNAMIC_DRAW GL_DYNAMIC_DRAW // set often & used many times
@@ -80,7 +103,7 @@ public:
 
     template<typename T>
     VertexArray && buffer_vertex_sub_data(unsigned int offset, std::vector<T> & data) {
-        return buffer_vertex_sub_data(offset, sizeof(T), data.size(), data.data());
+        return buffer_vertex_sub_data(offset, sizeof(T) * data.size(), data.data());
     }
     template<typename T>
     VertexArray && buffer_vertex_sub_data(unsigned int offset, T & data) {
@@ -92,10 +115,64 @@ public:
         return std::move(*this);
     }
     
-    VertexArray && assign_vertex_attribute(unsigned int location, unsigned int size, GLenum type, bool normalized, unsigned int stride = 0, unsigned int offset = 0) {        
+    template<typename T>
+    VertexArray && buffer_instance_data(std::vector<T> & data, GLenum draw_type) {
+        return buffer_instance_data(sizeof(T) * data.size(), data.data(), draw_type);
+    }
+    VertexArray && buffer_instance_data(unsigned int data_size, void * data, GLenum draw_type) {
+        bind();
+        get_instance_buffer().buffer_data(ARRAY_BUFFER, data_size, data, draw_type);
+        return std::move(*this);
+    }
+
+    template<typename T>
+    VertexArray && buffer_instance_sub_data(unsigned int offset, std::vector<T> & data) {
+        return buffer_instance_sub_data(offset, sizeof(T) * data.size(), data.data());
+    }
+    VertexArray && buffer_instance_sub_data(unsigned int offset, unsigned int data_size, void * data) {
+        bind();
+        get_instance_buffer().buffer_sub_data(ARRAY_BUFFER, offset, data_size, data);
+        return std::move(*this);
+    }
+    
+    // the index buffer is part of the vertex array state, so it is bound through bind() afterwards
+    template<typename T>
+    VertexArray && buffer_index_data(std::vector<T> & data, GLenum draw_type) {
+        return buffer_index_data(sizeof(T) * data.size(), data.data(), draw_type);
+    }
+    VertexArray && buffer_index_data(unsigned int data_size, void * data, GLenum draw_type) {
         bind();
+        get_index_buffer().buffer_data(ELEMENT_ARRAY_BUFFER, data_size, data, draw_type);
+        return std::move(*this);
+    }
+
+    template<typename T>
+    VertexArray && buffer_index_sub_data(unsigned int offset, std::vector<T> & data) {
+        return buffer_index_sub_data(offset, sizeof(T) * data.size(), data.data());
+    }
+    VertexArray && buffer_index_sub_data(unsigned int offset, unsigned int data_size, void * data) {
+        bind();
+        get_index_buffer().buffer_sub_data(ELEMENT_ARRAY_BUFFER, offset, data_size, data);
+        return std::move(*this);
+    }
+
+    // a divisor of 0 advances the attribute per vertex, n advances it once every n instances
+    VertexArray && assign_vertex_attribute(unsigned int location, unsigned int size, GLenum type, bool normalized, unsigned int stride = 0, unsigned int offset = 0, unsigned int divisor = 0) {        
+        bind();
+        vertex_buffer.bind(ARRAY_BUFFER);
+        glEnableVertexAttribArray(location);  
+        glVertexAttribPointer(location, size, type, normalized, stride, (const void*) (uintptr_t) offset);
+        glVertexAttribDivisor(location, divisor);
+        return std::move(*this);
+    }
+
+    // same as assign_vertex_attribute, but reads from the instance buffer
+    VertexArray && assign_instance_attribute(unsigned int location, unsigned int size, GLenum type, bool normalized, unsigned int stride = 0, unsigned int offset = 0, unsigned int divisor = 1) {        
+        bind();
+        get_instance_buffer().bind(ARRAY_BUFFER);
         glEnableVertexAttribArray(location);  
-        glVertexAttribPointer(location, size, type, normalized, stride, (const void*) offset);
+        glVertexAttribPointer(location, size, type, normalized, stride, (const void*) (uintptr_t) offset);
+        glVertexAttribDivisor(location, divisor);
         return std::move(*this);
     }
 
@@ -103,6 +180,16 @@ public:
         return vertex_buffer;
     }
 
+    Buffer & get_instance_buffer() {
+        if (instance_buffer == nullptr) instance_buffer = std::make_unique<Buffer>();
+        return *instance_buffer;
+    }
+
+    Buffer & get_index_buffer() {
+        if (index_buffer == nullptr) index_buffer = std::make_unique<Buffer>();
+        return *index_buffer;
+    }
+
 protected:
     static unsigned int current_bound;
 public: